@@ -0,0 +1,63 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Build step that packs the game's graphics and font into one asset pack and writes it
+as a C++ source file, so the pack is compiled into the game executable. Entries are
+named by their path relative to the root directory, the same names the game loads.
+
+Usage: CentipedeAssetPacker <output.cpp> <rootDir> <asset>...
+*/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "ECE_AssetPack.h"
+
+int main(int argc, char* argv[])
+{
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " <output.cpp> <rootDir> <asset>..." << std::endl;
+        return 1;
+    }
+    const std::string outputFile = argv[1];
+    const std::string rootDir = argv[2];
+    const std::vector<std::string> names(argv + 3, argv + argc);
+
+    std::vector<std::uint8_t> pack;
+    std::string error;
+    if (!buildAssetPack(rootDir, names, pack, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    // Open the pack the way the game will, so a pack it would reject never gets embedded
+    ECE_AssetPack check;
+    if (!check.open(pack.data(), pack.size(), error)) {
+        std::cerr << "Packed data failed its check: " << error << std::endl;
+        return 1;
+    }
+
+    // Bytes as an initializer list, string literals have length limits on some compilers
+    std::ostringstream source;
+    source << "// Generated by CentipedeAssetPacker, do not edit\n"
+           << "#include <cstddef>\n\n"
+           << "alignas(8) extern const unsigned char embeddedAssetPack[] = {\n";
+    for (std::size_t i = 0; i < pack.size(); ++i) {
+        source << (i % 16 == 0 ? "    " : " ") << "0x" << std::hex << std::setw(2) << std::setfill('0')
+               << static_cast<int>(pack[i]) << (i + 1 < pack.size() ? "," : "") << (i % 16 == 15 ? "\n" : "");
+    }
+    source << std::dec << "\n};\n"
+           << "extern const std::size_t embeddedAssetPackSize = sizeof(embeddedAssetPack);\n";
+
+    std::ofstream file(outputFile, std::ios::binary);
+    file << source.str();
+    if (!file) {
+        std::cerr << "Failed to write " << outputFile << std::endl;
+        return 1;
+    }
+
+    std::cout << "Packed " << check.getEntryCount() << " assets into " << pack.size() << " bytes" << std::endl;
+    return 0;
+}
@@ -0,0 +1,304 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Asset pack reading and building, and the LZ77 codec used for its entries.
+*/
+#include "ECE_AssetPack.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+// Codec parameters
+const std::size_t LZ_MIN_MATCH = 4;                 // Shorter matches cost more than the literals
+const std::size_t LZ_MAX_OFFSET = 65535;            // Offsets are 2 bytes
+const int LZ_HASH_BITS = 14;                        // Positions remembered by the compressor
+
+// Read 4 bytes for hashing and match tests
+static std::uint32_t readWord(const std::uint8_t* bytes)
+{
+    std::uint32_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+// Lengths of 15 and more continue in extra bytes of up to 255 each
+static void writeLength(std::vector<std::uint8_t>& output, std::size_t length)
+{
+    length -= 15;
+    while (length >= 255) {
+        output.push_back(255);
+        length -= 255;
+    }
+    output.push_back(static_cast<std::uint8_t>(length));
+}
+
+// Read the extra length bytes, false if they run past the input
+static bool readLength(const std::uint8_t* input, std::size_t inputSize, std::size_t& position, std::size_t& length)
+{
+    std::uint8_t extra;
+    do {
+        if (position >= inputSize) {
+            return false;
+        }
+        extra = input[position++];
+        length += extra;
+    } while (extra == 255);
+    return true;
+}
+
+// Emit one sequence: pending literals, then a match unless this is the last sequence
+static void writeSequence(std::vector<std::uint8_t>& output, const std::uint8_t* literals, std::size_t literalCount,
+                          std::size_t offset, std::size_t matchLength)
+{
+    const std::size_t matchCode = matchLength >= LZ_MIN_MATCH ? matchLength - LZ_MIN_MATCH : 0;
+    output.push_back(static_cast<std::uint8_t>((std::min<std::size_t>(literalCount, 15) << 4) | std::min<std::size_t>(matchCode, 15)));
+    if (literalCount >= 15) {
+        writeLength(output, literalCount);
+    }
+    output.insert(output.end(), literals, literals + literalCount);
+    if (matchLength == 0) {
+        return;
+    }
+    output.push_back(static_cast<std::uint8_t>(offset & 0xFF));
+    output.push_back(static_cast<std::uint8_t>(offset >> 8));
+    if (matchCode >= 15) {
+        writeLength(output, matchCode);
+    }
+}
+
+// Greedy matching against the last position each 4-byte sequence was seen at
+void compressAssetData(const std::uint8_t* input, std::size_t size, std::vector<std::uint8_t>& output)
+{
+    output.clear();
+    std::vector<std::uint32_t> lastSeen(std::size_t(1) << LZ_HASH_BITS, 0);  // Position + 1, 0 = never seen
+
+    std::size_t position = 0;
+    std::size_t anchor = 0;    // First byte not written yet
+    while (position + LZ_MIN_MATCH <= size) {
+        const std::uint32_t word = readWord(input + position);
+        const std::uint32_t hash = (word * 2654435761u) >> (32 - LZ_HASH_BITS);
+        const std::size_t candidate = lastSeen[hash];
+        lastSeen[hash] = static_cast<std::uint32_t>(position + 1);
+
+        if (candidate == 0 || position - (candidate - 1) > LZ_MAX_OFFSET || readWord(input + candidate - 1) != word) {
+            position++;
+            continue;
+        }
+
+        const std::size_t match = candidate - 1;
+        std::size_t length = LZ_MIN_MATCH;
+        while (position + length < size && input[match + length] == input[position + length]) {
+            length++;
+        }
+        writeSequence(output, input + anchor, position - anchor, position - match, length);
+        position += length;
+        anchor = position;
+    }
+    writeSequence(output, input + anchor, size - anchor, 0, 0);
+}
+
+// Every length and offset is checked against both buffers before copying
+bool decompressAssetData(const std::uint8_t* input, std::size_t inputSize, std::uint8_t* output, std::size_t outputSize)
+{
+    std::size_t in = 0;
+    std::size_t out = 0;
+    while (in < inputSize) {
+        const std::uint8_t token = input[in++];
+
+        std::size_t literalCount = token >> 4;
+        if (literalCount == 15 && !readLength(input, inputSize, in, literalCount)) {
+            return false;
+        }
+        if (literalCount > inputSize - in || literalCount > outputSize - out) {
+            return false;
+        }
+        if (literalCount > 0) {
+            std::memcpy(output + out, input + in, literalCount);
+        }
+        in += literalCount;
+        out += literalCount;
+
+        // The last sequence ends with its literals
+        if (in == inputSize) {
+            break;
+        }
+
+        if (inputSize - in < 2) {
+            return false;
+        }
+        const std::size_t offset = input[in] | (static_cast<std::size_t>(input[in + 1]) << 8);
+        in += 2;
+        std::size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(input, inputSize, in, matchLength)) {
+            return false;
+        }
+        matchLength += LZ_MIN_MATCH;
+        if (offset == 0 || offset > out || matchLength > outputSize - out) {
+            return false;
+        }
+
+        // Byte by byte, matches may overlap the bytes they produce
+        for (std::size_t i = 0; i < matchLength; ++i, ++out) {
+            output[out] = output[out - offset];
+        }
+    }
+    return out == outputSize;
+}
+
+// Constructor starts without a pack
+ECE_AssetPack::ECE_AssetPack()
+    : data(nullptr), size(0), entryCount(0)
+{
+}
+
+// Validate everything up front so lookups don't need to
+bool ECE_AssetPack::open(const std::uint8_t* packData, std::size_t packSize, std::string& error)
+{
+    data = nullptr;
+    AssetPackHeader header;
+    if (packSize < sizeof(header)) {
+        error = "asset pack is truncated";
+        return false;
+    }
+    std::memcpy(&header, packData, sizeof(header));
+    if (header.magic != ASSET_PACK_MAGIC || header.version != ASSET_PACK_VERSION || header.dataSize != packSize) {
+        error = "asset pack has a wrong header or version";
+        return false;
+    }
+    if (sizeof(header) + header.entryCount * sizeof(AssetPackEntry) > packSize) {
+        error = "asset pack index is truncated";
+        return false;
+    }
+
+    data = packData;
+    size = packSize;
+    entryCount = header.entryCount;
+    for (std::size_t i = 0; i < entryCount; ++i) {
+        const AssetPackEntry entry = getEntry(i);
+        if (entry.offset > size || entry.packedSize > size - entry.offset ||
+            (entry.method == ASSET_STORED && entry.packedSize != entry.size) ||
+            (entry.method != ASSET_STORED && entry.method != ASSET_LZ) ||
+            entry.name[ASSET_NAME_LENGTH - 1] != '\0') {
+            data = nullptr;
+            error = "asset pack entry " + std::to_string(i) + " is invalid";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Binary search, the builder sorts the index by name
+bool ECE_AssetPack::find(const std::string& name, AssetPackEntry& entry) const
+{
+    std::size_t low = 0;
+    std::size_t high = entryCount;
+    while (low < high) {
+        const std::size_t middle = (low + high) / 2;
+        entry = getEntry(middle);
+        const int order = std::strncmp(entry.name, name.c_str(), ASSET_NAME_LENGTH);
+        if (order == 0) {
+            return true;
+        }
+        if (order < 0) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    return false;
+}
+
+// Stored assets are handed out in place, compressed ones are unpacked into the buffer
+bool ECE_AssetPack::read(const std::string& name, const std::uint8_t*& assetData, std::size_t& assetSize,
+                         std::vector<std::uint8_t>& buffer, std::string& error) const
+{
+    AssetPackEntry entry;
+    if (!isOpen() || !find(name, entry)) {
+        error = "asset " + name + " is not in the pack";
+        return false;
+    }
+
+    if (entry.method == ASSET_STORED) {
+        assetData = data + entry.offset;
+        assetSize = entry.size;
+        return true;
+    }
+
+    buffer.resize(entry.size);
+    if (!decompressAssetData(data + entry.offset, entry.packedSize, buffer.data(), buffer.size())) {
+        error = "asset " + name + " is corrupt";
+        return false;
+    }
+    assetData = buffer.data();
+    assetSize = buffer.size();
+    return true;
+}
+
+// Copy the entry out instead of casting into the pack
+AssetPackEntry ECE_AssetPack::getEntry(std::size_t index) const
+{
+    AssetPackEntry entry;
+    std::memcpy(&entry, data + sizeof(AssetPackHeader) + index * sizeof(AssetPackEntry), sizeof(entry));
+    return entry;
+}
+
+// Read every file, keep the smaller of the raw and compressed forms, and lay out header, index and data
+bool buildAssetPack(const std::string& rootDir, const std::vector<std::string>& names,
+                    std::vector<std::uint8_t>& pack, std::string& error)
+{
+    std::vector<std::string> sortedNames(names);
+    std::sort(sortedNames.begin(), sortedNames.end());
+    if (sortedNames.size() > 0xFFFF) {
+        error = "too many assets";
+        return false;
+    }
+
+    AssetPackHeader header = { ASSET_PACK_MAGIC, ASSET_PACK_VERSION, static_cast<std::uint16_t>(sortedNames.size()), 0 };
+    std::vector<AssetPackEntry> entries(sortedNames.size());
+    std::vector<std::uint8_t> body;
+    std::vector<std::uint8_t> compressed;
+    const std::size_t dataStart = sizeof(header) + entries.size() * sizeof(AssetPackEntry);
+
+    for (std::size_t i = 0; i < sortedNames.size(); ++i) {
+        const std::string& name = sortedNames[i];
+        if (name.size() >= ASSET_NAME_LENGTH) {
+            error = "asset name is too long: " + name;
+            return false;
+        }
+        if (i > 0 && name == sortedNames[i - 1]) {
+            error = "asset is listed twice: " + name;
+            return false;
+        }
+
+        std::ifstream file(rootDir + "/" + name, std::ios::binary);
+        if (!file) {
+            error = "cannot open " + rootDir + "/" + name;
+            return false;
+        }
+        const std::vector<std::uint8_t> raw((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        compressAssetData(raw.data(), raw.size(), compressed);
+        const bool useCompressed = compressed.size() < raw.size();
+        const std::vector<std::uint8_t>& stored = useCompressed ? compressed : raw;
+
+        AssetPackEntry& entry = entries[i];
+        std::memset(&entry, 0, sizeof(entry));
+        std::memcpy(entry.name, name.c_str(), name.size());
+        entry.offset = static_cast<std::uint32_t>(dataStart + body.size());
+        entry.packedSize = static_cast<std::uint32_t>(stored.size());
+        entry.size = static_cast<std::uint32_t>(raw.size());
+        entry.method = useCompressed ? ASSET_LZ : ASSET_STORED;
+        body.insert(body.end(), stored.begin(), stored.end());
+    }
+
+    header.dataSize = static_cast<std::uint32_t>(dataStart + body.size());
+    pack.resize(sizeof(header));
+    std::memcpy(pack.data(), &header, sizeof(header));
+    const std::uint8_t* index = reinterpret_cast<const std::uint8_t*>(entries.data());
+    pack.insert(pack.end(), index, index + entries.size() * sizeof(AssetPackEntry));
+    pack.insert(pack.end(), body.begin(), body.end());
+    return true;
+}
@@ -0,0 +1,89 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Asset pack format for the graphics and the font. A pack is one binary blob: a small
+header, an index of fixed-size entries sorted by name, then the asset data. Each
+entry is either stored as is (PNGs are already compressed) or LZ-compressed, whichever
+is smaller. The build packs the asset folders with CentipedeAssetPacker and compiles
+the blob into the game, so loading an asset is an index lookup and at most one
+decompression, without touching the filesystem.
+*/
+#ifndef ECE_ASSETPACK_H
+#define ECE_ASSETPACK_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Pack header values
+const std::uint32_t ASSET_PACK_MAGIC = 0x4B415043;  // "CPAK"
+const std::uint16_t ASSET_PACK_VERSION = 1;
+const std::size_t ASSET_NAME_LENGTH = 48;           // Relative path, zero-padded
+
+// How an entry's data is kept in the pack
+enum AssetMethod : std::uint32_t {
+    ASSET_STORED = 0,          // Raw bytes
+    ASSET_LZ = 1               // LZ77 sequences, see compressAssetData
+};
+
+// Pack header, the index follows right after it
+struct AssetPackHeader {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t entryCount;
+    std::uint32_t dataSize;    // Size of the whole pack
+};
+
+// One asset in the index
+struct AssetPackEntry {
+    char name[ASSET_NAME_LENGTH];
+    std::uint32_t offset;      // From the start of the pack
+    std::uint32_t packedSize;  // Bytes in the pack
+    std::uint32_t size;        // Bytes once unpacked
+    std::uint32_t method;      // AssetMethod
+};
+
+// Read-only view of a pack in memory
+class ECE_AssetPack {
+public:
+    ECE_AssetPack();
+
+    // Checks the header and that every entry lies inside the pack, the memory must outlive the pack
+    bool open(const std::uint8_t* data, std::size_t size, std::string& error);
+
+    // Checks if a valid pack is open
+    bool isOpen() const { return data != nullptr; }
+
+    // Getter for the number of assets
+    std::size_t getEntryCount() const { return entryCount; }
+
+    // Looks an asset up in the index
+    bool find(const std::string& name, AssetPackEntry& entry) const;
+
+    // Gets an asset's bytes: points into the pack when it is stored, otherwise unpacks into buffer
+    bool read(const std::string& name, const std::uint8_t*& assetData, std::size_t& assetSize,
+              std::vector<std::uint8_t>& buffer, std::string& error) const;
+
+private:
+    // Copies an index entry out of the pack (the pack has no alignment guarantees)
+    AssetPackEntry getEntry(std::size_t index) const;
+
+    const std::uint8_t* data;
+    std::size_t size;
+    std::size_t entryCount;
+};
+
+// Builds a pack from files below a root directory, named by their relative paths
+bool buildAssetPack(const std::string& rootDir, const std::vector<std::string>& names,
+                    std::vector<std::uint8_t>& pack, std::string& error);
+
+// LZ77 compression with 64 KB offsets: each sequence is a token (literal count, match length),
+// the literals, then a 2-byte match offset; the last sequence has literals only
+void compressAssetData(const std::uint8_t* input, std::size_t size, std::vector<std::uint8_t>& output);
+
+// Unpacks data written by compressAssetData, false if it is corrupt or doesn't fill the output exactly
+bool decompressAssetData(const std::uint8_t* input, std::size_t inputSize, std::uint8_t* output, std::size_t outputSize);
+
+#endif // ECE_ASSETPACK_H
@@ -12,20 +12,23 @@ the appropriate action.
 */
 #include "ECE_Centipede.h"
 #include "ECE_LaserBlast.h"
+#include "ECE_Textures.h"
+#include "ECE_Metrics.h"
+#include <algorithm>
 
 // Constructor to initialize the centipede's texture, position, speed, and determine if it's a head or body
 ECE_Centipede::ECE_Centipede(sf::Texture& headTexture, sf::Texture& bodyTexture, float startX, float startY, float speed, int segmentIndex)
-    : speed(speed), direction(Direction::RIGHT), preDirection(Direction::RIGHT), x(startX), y(startY)
+    : speed(speed), direction(Direction::RIGHT), preDirection(Direction::RIGHT), x(startX), y(startY), trailOffset(0)
 {
     setScale(0.8f, 0.8f);  // Set the size of the centipede
 
     // Set the texture and head status based on segment index
     if (segmentIndex == 0) {
-        setTexture(headTexture);    // Apply the head texture
+        setSpriteTexture(*this, headTexture);    // Apply the head texture
         isHeadSegment = true;       // Mark this segment as the head
     }
     else {
-        setTexture(bodyTexture);    // Apply the body texture for other segments
+        setSpriteTexture(*this, bodyTexture);    // Apply the body texture for other segments
         isHeadSegment = false;      // This is not the head
     }
 
@@ -72,13 +75,13 @@ void ECE_Centipede::update()
     // After moving down, switch to the opposite horizontal direction
     if (direction == Direction::DOWN) {
         direction = (preDirection == Direction::LEFT) ? Direction::RIGHT : Direction::LEFT;
-        printf("Switching Horizontal Direction\n");
     }
 }
 
 // Check for collision between the centipede and another object
 bool ECE_Centipede::checkCollision(const sf::Sprite& otherObject)
 {
+    collisionTestCount++;
     return getGlobalBounds().intersects(otherObject.getGlobalBounds());
 }
 
@@ -98,7 +101,6 @@ void ECE_Centipede::checkBounds(float screenWidth, float screenHeight)
                 x = getGlobalBounds().width;  // Stay within the left boundary
             }
             direction = Direction::DOWN;  // Change direction to downwards
-            printf("Moving Down\n");
         }
     }
 
@@ -118,32 +120,46 @@ void ECE_Centipede::setDirection(Direction newDirection)
 }
 
 // Handle collisions between the centipede and mushrooms
-void ECE_Centipede::handleMushroomCollision(std::list<sf::Sprite>& mushrooms)
+void ECE_Centipede::handleMushroomCollision(std::list<ECE_Mushroom>& mushrooms)
 {
     for (auto& mushroom : mushrooms) {
         if (checkCollision(mushroom)) {
-            if (direction != Direction::DOWN) {
-                preDirection = direction;  // Store the current direction before changing
+            avoidMushroom();
+        }
+    }
+}
 
-                // Adjust position to avoid overlap with the mushroom
-                if (direction == Direction::RIGHT) {
-                    x -= getGlobalBounds().width / 2;  // Move left to avoid collision
-                }
-                else {
-                    x += getGlobalBounds().width / 2;  // Move right to avoid collision
-                }
+// Same turn as above, with one bitboard query instead of a walk over the list
+void ECE_Centipede::handleMushroomCollision(const ECE_MushroomGrid& grid)
+{
+    collisionTestCount++;
+    if (grid.anyInRect(getGlobalBounds())) {
+        avoidMushroom();
+    }
+}
 
-                direction = Direction::DOWN;  // Change direction to downwards
-                printf("Moving Down\n");
-            }
+// Step back half a segment and start moving down, unless already moving down
+void ECE_Centipede::avoidMushroom()
+{
+    if (direction != Direction::DOWN) {
+        preDirection = direction;  // Store the current direction before changing
+
+        // Adjust position to avoid overlap with the mushroom
+        if (direction == Direction::RIGHT) {
+            x -= getGlobalBounds().width / 2;  // Move left to avoid collision
+        }
+        else {
+            x += getGlobalBounds().width / 2;  // Move right to avoid collision
         }
+
+        direction = Direction::DOWN;  // Change direction to downwards
     }
 }
 
 // Handle collisions between centipedes and laser blasts
 int ECE_Centipede::handleLaserCollision(
     std::list<ECE_Centipede*>& centipedes,            // List of centipede segments
-    std::list<sf::Sprite>& mushrooms,                 // List of mushrooms
+    std::list<ECE_Mushroom>& mushrooms,               // List of mushrooms
     std::list<ECE_LaserBlast>& laserBlasts,           // List of laser blasts
     const sf::Texture& mushroomTexture,               // Texture for mushrooms
     const sf::Texture& centipedeTextureHead,          // Texture for centipede head
@@ -166,8 +182,7 @@ int ECE_Centipede::handleLaserCollision(
                 }
 
                 // Create a new mushroom at the position of the hit centipede segment
-                sf::Sprite mushroom(mushroomTexture);
-                mushroom.setScale(0.8f, 0.8f);
+                ECE_Mushroom mushroom(mushroomTexture);
                 mushroom.setPosition((*centipedeIt)->getPosition());
                 mushrooms.push_back(mushroom);  // Add mushroom to the list
 
@@ -176,7 +191,8 @@ int ECE_Centipede::handleLaserCollision(
                 // Save iterator to the previous segment
                 auto prevSegment = (centipedeIt == centipedes.begin()) ? centipedes.end() : std::prev(centipedeIt);
 
-                // Remove the current centipede segment
+                // Remove and free the current centipede segment, the list owns its segments
+                delete *centipedeIt;
                 centipedeIt = centipedes.erase(centipedeIt);
                 centipedeHit = true;
 
@@ -189,6 +205,7 @@ int ECE_Centipede::handleLaserCollision(
                 if (nextSegment == centipedes.end() || (prevSegment != centipedes.end() && (*prevSegment)->checkCollision(*laserIt))) {
                     // Both adjacent segments are gone, remove this segment
                     if (centipedeIt != centipedes.end()) {
+                        delete *centipedeIt;
                         centipedeIt = centipedes.erase(centipedeIt);
                     }
                 }
@@ -220,6 +237,7 @@ void ECE_Centipede::setAsHead(const sf::Texture& headTexture)
 bool ECE_Centipede::checkSpaceshipCollision(std::list<ECE_Centipede*>& centipedes, sf::Sprite& spaceship)
 {
     for (auto& centipede : centipedes) {
+        collisionTestCount++;
         if (centipede->getGlobalBounds().intersects(spaceship.getGlobalBounds())) {
             return true;  // Collision detected
         }
@@ -227,3 +245,270 @@ bool ECE_Centipede::checkSpaceshipCollision(std::list<ECE_Centipede*>& centipede
     return false;  // No collision
 }
 
+// Coordinates, speed, rotation, the three flags, position and origin
+const std::size_t ECE_Centipede::STATE_SIZE = 4 * sizeof(float) + 3 * sizeof(std::uint8_t) + 2 * sizeof(sf::Vector2f);
+
+// Checks a direction read from a snapshot, any other value would be an impossible movement state
+static bool validDirection(ECE_Centipede::Direction direction)
+{
+    return static_cast<int>(direction) >= 0 && direction <= ECE_Centipede::Direction::DOWN;
+}
+
+// Save the segment's movement state and sprite transform
+void ECE_Centipede::saveState(ECE_SnapshotWriter& writer) const
+{
+    writer.write(x);
+    writer.write(y);
+    writer.write(speed);
+    writer.write(static_cast<std::uint8_t>(direction));
+    writer.write(static_cast<std::uint8_t>(preDirection));
+    writer.write(static_cast<std::uint8_t>(isHeadSegment));
+    writer.write(getPosition());
+    writer.write(getOrigin());
+    writer.write(getRotation());
+}
+
+// Restore the segment's movement state and sprite transform
+bool ECE_Centipede::loadState(ECE_SnapshotReader& reader, const sf::Texture& headTexture, const sf::Texture& bodyTexture)
+{
+    std::uint8_t newDirection = 0, newPreDirection = 0, head = 0;
+    sf::Vector2f position, origin;
+    float rotation = 0;
+
+    if (!reader.read(x) || !reader.read(y) || !reader.read(speed) ||
+        !reader.read(newDirection) || !reader.read(newPreDirection) || !reader.read(head) ||
+        !reader.read(position) || !reader.read(origin) || !reader.read(rotation) ||
+        !validDirection(static_cast<Direction>(newDirection)) || !validDirection(static_cast<Direction>(newPreDirection))) {
+        return false;
+    }
+
+    direction = static_cast<Direction>(newDirection);
+    preDirection = static_cast<Direction>(newPreDirection);
+    isHeadSegment = head != 0;
+    setTexture(isHeadSegment ? headTexture : bodyTexture);  // The texture follows the head flag
+    setOrigin(origin.x, origin.y);
+    setPosition(position);
+    setRotation(rotation);
+    return true;
+}
+
+// Steps of path a trail can hold, enough for chains of about 60 segments at the default speed
+static const std::size_t TRAIL_CAPACITY = 256;
+
+// Constructor to allocate the ring buffer
+ECE_CentipedeTrail::ECE_CentipedeTrail(std::size_t capacity)
+    : points(capacity), newest(capacity - 1), count(0)
+{
+}
+
+// Write the newest point over the oldest slot
+void ECE_CentipedeTrail::push(const ECE_Centipede::TrailPoint& point)
+{
+    newest = (newest + 1) % points.size();
+    points[newest] = point;
+    if (count < points.size()) {
+        count++;
+    }
+}
+
+// Interpolate between the two recorded steps around stepsBack, clamped to the recorded range
+ECE_Centipede::TrailPoint ECE_CentipedeTrail::sample(float stepsBack) const
+{
+    const float oldest = static_cast<float>(count > 0 ? count - 1 : 0);
+    stepsBack = std::min(std::max(stepsBack, 0.0f), oldest);
+
+    const std::size_t step = static_cast<std::size_t>(stepsBack);
+    const float fraction = stepsBack - step;
+    const std::size_t capacity = points.size();
+    const ECE_Centipede::TrailPoint& newer = points[(newest + capacity - step) % capacity];
+    const ECE_Centipede::TrailPoint& older = points[(newest + capacity - std::min(step + 1, count - 1)) % capacity];
+
+    // Position between the two steps, orientation of the move toward the newer one
+    ECE_Centipede::TrailPoint point = newer;
+    point.x = newer.x + (older.x - newer.x) * fraction;
+    point.y = newer.y + (older.y - newer.y) * fraction;
+    return point;
+}
+
+// Write the capacity, the count and the recorded points oldest first, as at most two contiguous runs of the ring
+void ECE_CentipedeTrail::saveState(ECE_SnapshotWriter& writer) const
+{
+    writer.write(static_cast<std::uint32_t>(points.size()));
+    writer.write(static_cast<std::uint32_t>(count));
+
+    const std::size_t oldest = (newest + points.size() + 1 - count) % points.size();
+    const std::size_t firstRun = std::min(count, points.size() - oldest);
+    writer.writeBytes(&points[oldest], firstRun * sizeof(ECE_Centipede::TrailPoint));
+    writer.writeBytes(points.data(), (count - firstRun) * sizeof(ECE_Centipede::TrailPoint));
+}
+
+// Read a trail back with its points at the start of the ring, nullptr if the data is incomplete
+std::shared_ptr<ECE_CentipedeTrail> ECE_CentipedeTrail::loadState(ECE_SnapshotReader& reader)
+{
+    std::uint32_t capacity = 0, count = 0;
+    if (!reader.read(capacity) || !reader.read(count) || capacity == 0 || capacity > TRAIL_CAPACITY || count > capacity) {
+        return nullptr;
+    }
+
+    std::shared_ptr<ECE_CentipedeTrail> trail = std::make_shared<ECE_CentipedeTrail>(capacity);
+    if (!reader.readBytes(trail->points.data(), count * sizeof(ECE_Centipede::TrailPoint))) {
+        return nullptr;
+    }
+    for (std::uint32_t i = 0; i < count; ++i) {
+        if (!validDirection(trail->points[i].direction) || !validDirection(trail->points[i].preDirection)) {
+            return nullptr;
+        }
+    }
+    trail->count = count;
+    trail->newest = (count + capacity - 1) % capacity;
+    return trail;
+}
+
+// Pre-fill the trail with a straight path behind the head so the body starts laid out behind it
+void ECE_Centipede::startTrail()
+{
+    trail = std::make_shared<ECE_CentipedeTrail>(TRAIL_CAPACITY);
+    trailOffset = 0;
+
+    const float stepX = (direction == Direction::LEFT) ? -speed : speed;
+    for (std::size_t n = TRAIL_CAPACITY; n-- > 0; ) {
+        trail->push({ x - stepX * n, y, getRotation(), direction, preDirection });
+    }
+}
+
+// Share the trail of the segment ahead, one step per speed pixels further back
+void ECE_Centipede::joinChain(const ECE_Centipede& ahead, float spacing)
+{
+    if (!ahead.trail || speed <= 0) {
+        return;
+    }
+    trail = ahead.trail;
+    trailOffset = ahead.trailOffset + spacing / speed;
+    followTrail();
+}
+
+// Place a body segment on the trail and take over the head's movement state at that point
+void ECE_Centipede::followTrail()
+{
+    const TrailPoint point = trail->sample(trailOffset);
+    x = point.x;
+    y = point.y;
+    direction = point.direction;
+    preDirection = point.preDirection;
+
+    setOrigin(getGlobalBounds().width / 2, getGlobalBounds().height / 2);
+    setPosition(x, y);
+    setRotation(point.rotation);
+}
+
+// Heads run the boundary and mushroom logic and record their path, body segments only sample it
+void ECE_Centipede::updateChains(std::list<ECE_Centipede*>& centipedes, std::list<ECE_Mushroom>& mushrooms, float screenWidth, float screenHeight,
+                                 const ECE_MushroomGrid* grid)
+{
+    std::shared_ptr<ECE_CentipedeTrail> chainTrail;  // Trail of the last head seen
+    std::shared_ptr<ECE_CentipedeTrail> splitTrail;  // Trail the last head was split from
+    float splitOffset = 0;                           // Where on that trail the last head was
+
+    for (auto& segment : centipedes) {
+        if (segment->isHeadSegment) {
+            splitTrail.reset();
+            if (!segment->trail) {
+                segment->startTrail();
+            }
+            else if (segment->trailOffset != 0) {
+                // A body segment that became a head after a split: copy its part of the old trail.
+                // If the old head already moved this tick, the old trail is one step further ahead.
+                splitTrail = segment->trail;
+                splitOffset = segment->trailOffset;
+                const float start = splitOffset + (splitTrail == chainTrail ? 1.0f : 0.0f);
+
+                auto newTrail = std::make_shared<ECE_CentipedeTrail>(splitTrail->capacity());
+                for (float n = static_cast<float>(splitTrail->size()) - 1 - start; n >= 0; n -= 1) {
+                    newTrail->push(splitTrail->sample(start + n));
+                }
+                segment->trail = newTrail;
+                segment->trailOffset = 0;
+            }
+
+            chainTrail = segment->trail;
+            segment->checkBounds(screenWidth, screenHeight);
+            if (grid) {
+                segment->handleMushroomCollision(*grid);
+            }
+            else {
+                segment->handleMushroomCollision(mushrooms);
+            }
+            segment->update();
+            chainTrail->push({ segment->x, segment->y, segment->getRotation(), segment->direction, segment->preDirection });
+        }
+        else if (segment->trail && segment->trail == splitTrail) {
+            // Follower of a split-off head: move it onto the new trail
+            segment->trail = chainTrail;
+            segment->trailOffset -= splitOffset;
+            segment->followTrail();
+        }
+        else if (segment->trail) {
+            segment->followTrail();
+        }
+        else {
+            // A segment that never joined a chain moves on its own
+            segment->checkBounds(screenWidth, screenHeight);
+            if (grid) {
+                segment->handleMushroomCollision(*grid);
+            }
+            else {
+                segment->handleMushroomCollision(mushrooms);
+            }
+            segment->update();
+        }
+    }
+}
+
+// Write each distinct trail once, then every segment's trail index and offset
+void ECE_Centipede::saveTrails(const std::list<ECE_Centipede*>& centipedes, ECE_SnapshotWriter& writer)
+{
+    std::vector<const ECE_CentipedeTrail*> trails;
+    for (const auto& segment : centipedes) {
+        if (segment->trail && std::find(trails.begin(), trails.end(), segment->trail.get()) == trails.end()) {
+            trails.push_back(segment->trail.get());
+        }
+    }
+
+    writer.write(static_cast<std::uint32_t>(trails.size()));
+    for (const auto& chainTrail : trails) {
+        chainTrail->saveState(writer);
+    }
+
+    for (const auto& segment : centipedes) {
+        const auto found = std::find(trails.begin(), trails.end(), segment->trail.get());
+        writer.write(segment->trail ? static_cast<std::int32_t>(found - trails.begin()) : std::int32_t(-1));
+        writer.write(segment->trailOffset);
+    }
+}
+
+// Rebuild the shared trails and reconnect the segments to them
+bool ECE_Centipede::loadTrails(std::list<ECE_Centipede*>& centipedes, ECE_SnapshotReader& reader)
+{
+    std::uint32_t trailCount = 0;
+    if (!reader.readCount(trailCount, 2 * sizeof(std::uint32_t))) {
+        return false;
+    }
+
+    std::vector<std::shared_ptr<ECE_CentipedeTrail>> trails;
+    for (std::uint32_t i = 0; i < trailCount; ++i) {
+        std::shared_ptr<ECE_CentipedeTrail> chainTrail = ECE_CentipedeTrail::loadState(reader);
+        if (!chainTrail) {
+            return false;
+        }
+        trails.push_back(chainTrail);
+    }
+
+    for (auto& segment : centipedes) {
+        std::int32_t index = -1;
+        if (!reader.read(index) || !reader.read(segment->trailOffset) || index >= static_cast<std::int32_t>(trails.size())) {
+            return false;
+        }
+        segment->trail = index >= 0 ? trails[index] : nullptr;
+    }
+    return true;
+}
@@ -17,7 +17,13 @@ the appropriate action.
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <list>
+#include <memory>
 #include "ECE_LaserBlast.h"
+#include "ECE_Mushroom.h"
+#include "ECE_MushroomGrid.h"
+#include "ECE_Snapshot.h"
+
+class ECE_CentipedeTrail;
 
 // ECE_Centipede class representing a segment of the centipede in the game
 class ECE_Centipede : public sf::Sprite
@@ -31,6 +37,15 @@ public:
         DOWN
     };
 
+    // One recorded step of a head: where it went and how it was moving afterwards
+    struct TrailPoint {
+        float x;
+        float y;
+        float rotation;
+        Direction direction;
+        Direction preDirection;
+    };
+
     // Constructor to initialize the centipede with textures, starting position, and speed
     ECE_Centipede(sf::Texture& headTexture, sf::Texture& bodyTexture, float startX, float startY, float speed, int segmentIndex);
 
@@ -50,7 +65,10 @@ public:
     void setDirection(Direction newDirection);
 
     // Handles collision with mushrooms
-    void handleMushroomCollision(std::list<sf::Sprite>& mushrooms);
+    void handleMushroomCollision(std::list<ECE_Mushroom>& mushrooms);
+
+    // Handles collision with mushrooms in grid-snapped mode, testing the tiles under the segment
+    void handleMushroomCollision(const ECE_MushroomGrid& grid);
 
     // Static method to check collision with the spaceship
     static bool checkSpaceshipCollision(std::list<ECE_Centipede*>& centipedes, sf::Sprite& spaceship);
@@ -58,7 +76,7 @@ public:
     // Handles laser collisions, splitting the centipede if hit
     static int handleLaserCollision(
         std::list<ECE_Centipede*>& centipedes,
-        std::list<sf::Sprite>& mushrooms,
+        std::list<ECE_Mushroom>& mushrooms,
         std::list<ECE_LaserBlast>& laserBlasts,
         const sf::Texture& mushroomTexture,
         const sf::Texture& centipedeTextureHead,
@@ -72,7 +90,39 @@ public:
     // Sets the current segment as the head of the centipede
     void setAsHead(const sf::Texture& headTexture);
 
+    // Getters for the current and previous movement directions
+    Direction getDirection() const { return direction; }
+    Direction getPreDirection() const { return preDirection; }
+
+    // Trail movement: only heads decide where to go, body segments replay the head's path.
+    // Updates every chain in the list by one step, with mushroom checks on the grid when one is given.
+    static void updateChains(std::list<ECE_Centipede*>& centipedes, std::list<ECE_Mushroom>& mushrooms, float screenWidth, float screenHeight,
+                             const ECE_MushroomGrid* grid = nullptr);
+
+    // Starts a new trail for this segment as a head, pre-filled as if it had been moving in a straight line
+    void startTrail();
+
+    // Joins the chain of the segment ahead, following the same trail spacing pixels behind it.
+    // Does nothing if the segment ahead isn't on a trail.
+    void joinChain(const ECE_Centipede& ahead, float spacing);
+
+    // Writes and restores the trails shared by the segments in the list
+    static void saveTrails(const std::list<ECE_Centipede*>& centipedes, ECE_SnapshotWriter& writer);
+    static bool loadTrails(std::list<ECE_Centipede*>& centipedes, ECE_SnapshotReader& reader);
+
+    // Writes the full segment state (movement, head flag and sprite transform) into a snapshot
+    void saveState(ECE_SnapshotWriter& writer) const;
+
+    // Bytes saveState writes per segment
+    static const std::size_t STATE_SIZE;
+
+    // Restores the segment state from a snapshot, returns false if the data is incomplete
+    bool loadState(ECE_SnapshotReader& reader, const sf::Texture& headTexture, const sf::Texture& bodyTexture);
+
 private:
+    // Steps back from a mushroom and turns downwards
+    void avoidMushroom();
+
     // Speed of the centipede's movement
     float speed;
 
@@ -86,6 +136,43 @@ private:
 
     // Flag indicating if this segment is the head of the centipede
     bool isHeadSegment;
+
+    // Trail movement: the chain's shared path and how many steps behind the head this segment is
+    std::shared_ptr<ECE_CentipedeTrail> trail;
+    float trailOffset;
+
+    // Moves a body segment to its place on the trail
+    void followTrail();
+};
+
+// Ring buffer of the positions a head has passed through, newest last
+class ECE_CentipedeTrail {
+public:
+    // Constructor to allocate the ring buffer
+    explicit ECE_CentipedeTrail(std::size_t capacity);
+
+    // Records the head's newest position, overwriting the oldest when full
+    void push(const ECE_Centipede::TrailPoint& point);
+
+    // Position a number of steps behind the newest one, interpolated between recorded steps
+    ECE_Centipede::TrailPoint sample(float stepsBack) const;
+
+    // Number of recorded steps
+    std::size_t size() const { return count; }
+
+    // Getter for the allocated length
+    std::size_t capacity() const { return points.size(); }
+
+    // Writes the recorded points into a snapshot, oldest first
+    void saveState(ECE_SnapshotWriter& writer) const;
+
+    // Reads a trail written by saveState, returns nullptr if the data is incomplete
+    static std::shared_ptr<ECE_CentipedeTrail> loadState(ECE_SnapshotReader& reader);
+
+private:
+    std::vector<ECE_Centipede::TrailPoint> points;
+    std::size_t newest;   // Index of the newest point
+    std::size_t count;    // Number of valid points
 };
 
 #endif // ECE_CENTIPEDE_H
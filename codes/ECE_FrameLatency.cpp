@@ -0,0 +1,83 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Input-to-present latency samples: stamping, CSV export and a percentile summary.
+*/
+#include "ECE_FrameLatency.h"
+#include <algorithm>
+#include <fstream>
+
+// Constructor reserves the sample storage so recording doesn't allocate during play
+ECE_LatencyRecorder::ECE_LatencyRecorder()
+    : pendingInputMicros(-1), samplesDropped(0)
+{
+    samples.reserve(MAX_LATENCY_SAMPLES);
+}
+
+// Remember when the newest input was sampled
+void ECE_LatencyRecorder::inputSampled()
+{
+    pendingInputMicros = clock.getElapsedTime().asMicroseconds();
+}
+
+// Pair the present time with the newest input, frames without a new input aren't counted
+void ECE_LatencyRecorder::framePresented()
+{
+    if (pendingInputMicros < 0) {
+        return;
+    }
+
+    FrameLatency sample = { pendingInputMicros, clock.getElapsedTime().asMicroseconds() };
+    pendingInputMicros = -1;
+    if (samples.size() < MAX_LATENCY_SAMPLES) {
+        samples.push_back(sample);
+    }
+    else {
+        samplesDropped++;
+    }
+}
+
+// One line per sample after a header line
+bool ECE_LatencyRecorder::writeCsv(const std::string& filename) const
+{
+    std::ofstream file(filename);
+    if (!file) {
+        return false;
+    }
+
+    file << "frame,input_us,present_us,latency_us\n";
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        file << i << ',' << samples[i].inputMicros << ',' << samples[i].presentMicros << ','
+             << samples[i].presentMicros - samples[i].inputMicros << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+// Sort a copy of the latencies and read the percentiles off it
+void ECE_LatencyRecorder::printSummary(std::ostream& out, const std::string& label) const
+{
+    if (samples.empty()) {
+        out << label << ": no input-to-present samples" << std::endl;
+        return;
+    }
+
+    std::vector<std::int64_t> latencies;
+    latencies.reserve(samples.size());
+    std::int64_t total = 0;
+    for (const auto& sample : samples) {
+        latencies.push_back(sample.presentMicros - sample.inputMicros);
+        total += latencies.back();
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    auto percentile = [&](double fraction) {
+        return latencies[static_cast<std::size_t>(fraction * (latencies.size() - 1))];
+    };
+    out << label << ": " << latencies.size() << " frames"
+        << (samplesDropped ? " (+" + std::to_string(samplesDropped) + " not kept)" : std::string())
+        << ", input-to-present us mean/p50/p95/p99/max "
+        << total / static_cast<std::int64_t>(latencies.size()) << "/" << percentile(0.5) << "/"
+        << percentile(0.95) << "/" << percentile(0.99) << "/" << latencies.back() << std::endl;
+}
@@ -0,0 +1,52 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Input-to-present latency recording. The game stamps the moment it samples the
+player's input and the moment a frame showing the result of that input is handed
+to the display. Each presented frame that reflects a new input gives one sample.
+The samples can be written as CSV for graphing and summarized as percentiles.
+*/
+#ifndef ECE_FRAMELATENCY_H
+#define ECE_FRAMELATENCY_H
+
+#include <SFML/System.hpp>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Constants
+const std::size_t MAX_LATENCY_SAMPLES = 1 << 18;  // Samples kept, later frames are only counted
+
+// One presented frame and the input it shows
+struct FrameLatency {
+    std::int64_t inputMicros;     // When the input was sampled, since the recorder started
+    std::int64_t presentMicros;   // When the frame was presented
+};
+
+class ECE_LatencyRecorder {
+public:
+    ECE_LatencyRecorder();
+
+    // Stamps an input sample, the next presented frame reflects it
+    void inputSampled();
+
+    // Stamps a presented frame, recording a sample if an input was taken since the last one
+    void framePresented();
+
+    // Writes the samples as CSV: frame, input time, present time and latency in microseconds
+    bool writeCsv(const std::string& filename) const;
+
+    // Prints the sample count and the mean, median, 95th and 99th percentile and worst latency
+    void printSummary(std::ostream& out, const std::string& label) const;
+
+private:
+    sf::Clock clock;
+    std::vector<FrameLatency> samples;
+    std::int64_t pendingInputMicros;  // Newest input not presented yet, -1 if none
+    std::uint64_t samplesDropped;     // Samples past MAX_LATENCY_SAMPLES
+};
+
+#endif // ECE_FRAMELATENCY_H
@@ -9,10 +9,12 @@ appropriate action. Make sure to allow for the movement of multiple laser blasts
 using a std::list.
 */
 #include "ECE_LaserBlast.h"
+#include "ECE_Textures.h"
+#include "ECE_Metrics.h"
 
 // Constructor to initialize the laser blast with a texture and set its position off-screen
-ECE_LaserBlast::ECE_LaserBlast(const sf::Texture& texture) {
-    setTexture(texture);
+ECE_LaserBlast::ECE_LaserBlast(const sf::Texture& texture) : active(false) {
+    setSpriteTexture(*this, texture);
     setPosition(-100, -100); // Initial position off-screen
 }
 
@@ -31,24 +33,37 @@ void ECE_LaserBlast::resetPosition(const sf::Vector2f& position) {
     setPosition(position);
 }
 
+// Moves the laser to the firing position and marks it in flight
+void ECE_LaserBlast::fire(const sf::Vector2f& position) {
+    setPosition(position);
+    active = true;
+}
+
+// Moves the laser off-screen and marks it idle
+void ECE_LaserBlast::park() {
+    setPosition(-100, -100);
+    active = false;
+}
+
 // Handles collisions between lasers and mushrooms
 int ECE_LaserBlast::checkLaserMushroomCollision(
     std::list<ECE_LaserBlast>& laserBlasts,
-    std::list<sf::Sprite>& mushrooms,
-    sf::Texture& textureMushroom0,
-    sf::Texture& textureMushroom1,
+    std::list<ECE_Mushroom>& mushrooms,
+    const sf::Texture& textureMushroom1,
     const sf::Texture& textureLaser,
-    int score
+    int score,
+    std::vector<sf::FloatRect>* changedRegions
 ) {
     for (auto laserIt = laserBlasts.begin(); laserIt != laserBlasts.end(); ) {
         bool laserHit = false;
 
         for (auto mushroomIt = mushrooms.begin(); mushroomIt != mushrooms.end(); ) {
+            collisionTestCount++;
             if (laserIt->getGlobalBounds().intersects(mushroomIt->getGlobalBounds())) {
-                if (mushroomIt->getTexture() == &textureMushroom0) {
-                    mushroomIt->setTexture(textureMushroom1);
+                if (changedRegions) {
+                    changedRegions->push_back(mushroomIt->getGlobalBounds());
                 }
-                else {
+                if (mushroomIt->hit(textureMushroom1)) {
                     mushroomIt = mushrooms.erase(mushroomIt); // Remove mushroom
                     score += 4;
                     continue; // Next mushroom
@@ -76,6 +91,58 @@ int ECE_LaserBlast::checkLaserMushroomCollision(
     return score;
 }
 
+// Handles collisions between lasers and mushrooms on the tile map
+int ECE_LaserBlast::checkLaserMushroomGridCollision(
+    std::list<ECE_LaserBlast>& laserBlasts,
+    std::list<ECE_Mushroom>& mushrooms,
+    ECE_MushroomGrid& grid,
+    const sf::Texture& textureMushroom1,
+    const sf::Texture& textureLaser,
+    int score,
+    std::vector<sf::FloatRect>* changedRegions
+) {
+    for (auto laserIt = laserBlasts.begin(); laserIt != laserBlasts.end(); ) {
+        bool laserHit = false;
+
+        int column, row;
+        while (!laserHit) {
+            collisionTestCount++;
+            if (!grid.findInRect(laserIt->getGlobalBounds(), column, row)) {
+                break;
+            }
+            auto mushroomIt = grid.findMushroom(column, row);
+            if (changedRegions) {
+                changedRegions->push_back(mushroomIt->getGlobalBounds());
+            }
+            if (grid.isDamaged(column, row)) {
+                // A second hit destroys the mushroom, and destroyed mushrooms don't stop the laser, same as the list version
+                grid.remove(column, row);
+                mushrooms.erase(mushroomIt);
+                score += 4;
+                continue;
+            }
+            mushroomIt->hit(textureMushroom1);
+            grid.setDamaged(column, row);
+            laserHit = true;
+        }
+
+        if (laserHit) {
+            laserIt = laserBlasts.erase(laserIt); // Remove laser
+
+            // Replenish lasers if below limit
+            if (laserBlasts.size() < 21) {
+                ECE_LaserBlast laser(textureLaser);
+                laser.setScale(0.5f, 0.5f);
+                laserBlasts.push_back(laser);
+            }
+        }
+        else {
+            ++laserIt; // Next laser
+        }
+    }
+    return score;
+}
+
 // Check for collisions between lasers and a spider
 int ECE_LaserBlast::checkLaserSpiderCollision(
     std::list<ECE_LaserBlast>& laserBlasts,
@@ -85,6 +152,7 @@ int ECE_LaserBlast::checkLaserSpiderCollision(
     int score
 ) {
     for (auto laserIt = laserBlasts.begin(); laserIt != laserBlasts.end(); ) {
+        collisionTestCount++;
         if (laserIt->getGlobalBounds().intersects(spider.getGlobalBounds())) {
             laserIt = laserBlasts.erase(laserIt); // Remove laser
             spider.setPosition(-300, -300); // Move spider off-screen
@@ -13,6 +13,9 @@ using a std::list.
 
 #include <SFML/Graphics.hpp>
 #include <list>
+#include <vector>
+#include "ECE_Mushroom.h"
+#include "ECE_MushroomGrid.h"
 
 class ECE_LaserBlast : public sf::Sprite {
 public:
@@ -28,14 +31,34 @@ public:
     // Resets the position of the laser blast to the specified location
     void resetPosition(const sf::Vector2f& position);
 
+    // Fires the laser from the specified location, making it active
+    void fire(const sf::Vector2f& position);
+
+    // Parks the laser off-screen until it is fired again
+    void park();
+
+    // Checks if the laser is in flight (idle lasers are parked and skipped when drawing)
+    bool isActive() const { return active; }
+
     // Checks for collisions between laser blasts and mushrooms, handling the outcome
     static int checkLaserMushroomCollision(
         std::list<ECE_LaserBlast>& laserBlasts,            // List of active laser blasts
-        std::list<sf::Sprite>& mushrooms,                  // List of mushrooms in the game
-        sf::Texture& textureMushroom0,                    // Texture for mushroom when damaged
-        sf::Texture& textureMushroom1,                    // Texture for mushroom when further damaged
+        std::list<ECE_Mushroom>& mushrooms,                // List of mushrooms in the game
+        const sf::Texture& textureMushroom1,               // Texture for mushroom when damaged
         const sf::Texture& textureLaser,                   // Original texture of the laser
-        int score                                           // Current score to update
+        int score,                                         // Current score to update
+        std::vector<sf::FloatRect>* changedRegions = nullptr // Receives the bounds of damaged and destroyed mushrooms
+    );
+
+    // Same as above in grid-snapped mode: finds hit mushrooms through the tile map and keeps it up to date
+    static int checkLaserMushroomGridCollision(
+        std::list<ECE_LaserBlast>& laserBlasts,            // List of active laser blasts
+        std::list<ECE_Mushroom>& mushrooms,                // List of mushrooms in the game
+        ECE_MushroomGrid& grid,                            // Tile map mirroring the mushroom list
+        const sf::Texture& textureMushroom1,               // Texture for mushroom when damaged
+        const sf::Texture& textureLaser,                   // Original texture of the laser
+        int score,                                         // Current score to update
+        std::vector<sf::FloatRect>* changedRegions = nullptr // Receives the bounds of damaged and destroyed mushrooms
     );
 
     // Checks for collisions between laser blasts and a spider, updating the score if needed
@@ -46,6 +69,10 @@ public:
         const sf::Texture& textureLaser,                   // Original texture of the laser
         int score                                           // Current score to update
     );
+
+private:
+    // Flag indicating if the laser was fired and hasn't left the screen yet
+    bool active;
 };
 
 #endif // ECE_LASERBLAST_H
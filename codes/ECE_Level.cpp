@@ -0,0 +1,281 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Data-driven level files. A level is a compact binary file: a fixed header (playfield
+size, spider parameters, record counts and offsets) followed by arrays of fixed-size
+mushroom and centipede wave records. ECE_Level memory-maps the file and hands out
+pointers straight into the mapping, so opening a level validates the records in place
+without copying them. convertTextLevel builds the binary file from a human-editable
+text form.
+
+Text form, one entry per line, '#' starts a comment:
+    playfield <width> <height>
+    spider <speedX> <speedY> <minY> <startX> <startY>
+    mushroom <x> <y> [damage]
+    wave <centipedes> <length> <speed> <startX> <startY> [rowSpacing]
+*/
+#include "ECE_Level.h"
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Records are read in place, so their layout must not depend on the compiler
+static_assert(sizeof(LevelSpider) == 20, "LevelSpider layout changed");
+static_assert(sizeof(LevelMushroom) == 12, "LevelMushroom layout changed");
+static_assert(sizeof(LevelWave) == 24, "LevelWave layout changed");
+static_assert(sizeof(LevelHeader) == 52, "LevelHeader layout changed");
+
+// Checks that an array of records lies inside the file and is aligned for the record type
+// (the mapping itself is page-aligned, so the offset decides the alignment)
+template <typename Record>
+static bool recordsFit(std::uint32_t offset, std::uint32_t count, std::size_t fileSize)
+{
+    return offset % alignof(Record) == 0 && offset <= fileSize && count <= (fileSize - offset) / sizeof(Record);
+}
+
+// Checks the playfield size the game divides into tiles and places things in
+static bool validPlayfield(float width, float height)
+{
+    return std::isfinite(width) && std::isfinite(height) && width > 0 && height > 0 &&
+        width <= LEVEL_MAX_PLAYFIELD && height <= LEVEL_MAX_PLAYFIELD;
+}
+
+// Checks that a mushroom lies on the playfield (the tile map converts its position to a tile) with a known
+// damage; NaN and infinite positions fail the range comparisons
+static bool validMushroom(const LevelMushroom& mushroom, float width, float height)
+{
+    return mushroom.x >= 0 && mushroom.x < width && mushroom.y >= 0 && mushroom.y < height && mushroom.damage <= 1;
+}
+
+// Checks that a wave spawns a bounded number of segments the game can move
+static bool validWave(const LevelWave& wave)
+{
+    return wave.centipedes <= LEVEL_MAX_CENTIPEDES && wave.length <= LEVEL_MAX_LENGTH &&
+        std::isfinite(wave.speed) && std::isfinite(wave.startX) && std::isfinite(wave.startY) && std::isfinite(wave.rowSpacing);
+}
+
+// Constructor starts with no level mapped
+ECE_Level::ECE_Level()
+    : header(nullptr), mushrooms(nullptr), waves(nullptr), mapping(nullptr), mappingSize(0)
+{
+}
+
+// Unmap the file on destruction
+ECE_Level::~ECE_Level()
+{
+    close();
+}
+
+// Map the whole file read-only and point the record views into it
+bool ECE_Level::open(const std::string& filename, std::string& error)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        error = "cannot open " + filename;
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        error = "cannot read the size of " + filename;
+        return false;
+    }
+    HANDLE fileMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!fileMapping) {
+        error = "cannot map " + filename;
+        return false;
+    }
+    mapping = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(fileMapping);
+    mappingSize = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int file = ::open(filename.c_str(), O_RDONLY);
+    if (file < 0) {
+        error = "cannot open " + filename;
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(file, &fileStat) != 0) {
+        ::close(file);
+        error = "cannot read the size of " + filename;
+        return false;
+    }
+    mappingSize = static_cast<std::size_t>(fileStat.st_size);
+    mapping = mappingSize ? mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, file, 0) : MAP_FAILED;
+    ::close(file);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+    }
+#endif
+    if (!mapping) {
+        error = "cannot map " + filename;
+        return false;
+    }
+
+    // Validate the header and the record arrays before handing out any pointer
+    const std::uint8_t* bytes = static_cast<const std::uint8_t*>(mapping);
+    const LevelHeader* candidate = reinterpret_cast<const LevelHeader*>(bytes);
+    if (mappingSize < sizeof(LevelHeader) || candidate->magic != LEVEL_MAGIC || candidate->version != LEVEL_VERSION) {
+        error = filename + " is not a level file of version " + std::to_string(LEVEL_VERSION);
+        close();
+        return false;
+    }
+    if (!recordsFit<LevelMushroom>(candidate->mushroomOffset, candidate->mushroomCount, mappingSize) ||
+        !recordsFit<LevelWave>(candidate->waveOffset, candidate->waveCount, mappingSize)) {
+        error = filename + " is truncated or corrupt";
+        close();
+        return false;
+    }
+    if (!validPlayfield(candidate->playfieldWidth, candidate->playfieldHeight)) {
+        error = filename + " has an invalid playfield size";
+        close();
+        return false;
+    }
+
+    // The game loops over every segment of a wave, so the counts must be bounded before it sees them
+    const LevelWave* candidateWaves = reinterpret_cast<const LevelWave*>(bytes + candidate->waveOffset);
+    for (std::uint32_t i = 0; i < candidate->waveCount; ++i) {
+        if (!validWave(candidateWaves[i])) {
+            error = filename + ": wave " + std::to_string(i + 1) + " is invalid (at most " + std::to_string(LEVEL_MAX_CENTIPEDES) +
+                " centipedes of " + std::to_string(LEVEL_MAX_LENGTH) + " segments)";
+            close();
+            return false;
+        }
+    }
+
+    // Mushroom positions become tile indices, so they must be on the playfield
+    const LevelMushroom* candidateMushrooms = reinterpret_cast<const LevelMushroom*>(bytes + candidate->mushroomOffset);
+    for (std::uint32_t i = 0; i < candidate->mushroomCount; ++i) {
+        if (!validMushroom(candidateMushrooms[i], candidate->playfieldWidth, candidate->playfieldHeight)) {
+            error = filename + ": mushroom " + std::to_string(i + 1) + " is outside the playfield or has an invalid damage";
+            close();
+            return false;
+        }
+    }
+
+    header = candidate;
+    mushrooms = candidateMushrooms;
+    waves = candidateWaves;
+    return true;
+}
+
+// Release the mapping
+void ECE_Level::close()
+{
+    if (mapping) {
+#ifdef _WIN32
+        UnmapViewOfFile(mapping);
+#else
+        munmap(mapping, mappingSize);
+#endif
+    }
+    header = nullptr;
+    mushrooms = nullptr;
+    waves = nullptr;
+    mapping = nullptr;
+    mappingSize = 0;
+}
+
+// Parse the text form line by line, then write header, mushrooms and waves
+bool convertTextLevel(const std::string& textFilename, const std::string& levelFilename, std::string& error)
+{
+    std::ifstream input(textFilename);
+    if (!input) {
+        error = "cannot open " + textFilename;
+        return false;
+    }
+
+    // Defaults match the built-in level
+    LevelHeader header = {};
+    header.magic = LEVEL_MAGIC;
+    header.version = LEVEL_VERSION;
+    header.playfieldWidth = 960;
+    header.playfieldHeight = 540;
+    header.spider = { 0.02f, 0.03f, 300, -1, -1 };  // Negative start = bottom-right corner
+
+    std::vector<LevelMushroom> mushrooms;
+    std::vector<LevelWave> waves;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(input, line)) {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string keyword;
+        if (!(fields >> keyword)) {
+            continue;  // Blank or comment line
+        }
+
+        bool valid = true;
+        if (keyword == "playfield") {
+            valid = fields >> header.playfieldWidth >> header.playfieldHeight &&
+                validPlayfield(header.playfieldWidth, header.playfieldHeight);
+        }
+        else if (keyword == "spider") {
+            LevelSpider& spider = header.spider;
+            valid = static_cast<bool>(fields >> spider.speedX >> spider.speedY >> spider.minY >> spider.startX >> spider.startY);
+        }
+        else if (keyword == "mushroom") {
+            LevelMushroom mushroom = {};
+            valid = static_cast<bool>(fields >> mushroom.x >> mushroom.y);
+            fields >> mushroom.damage;
+            mushrooms.push_back(mushroom);
+        }
+        else if (keyword == "wave") {
+            LevelWave wave = {};
+            wave.rowSpacing = 40;
+            valid = static_cast<bool>(fields >> wave.centipedes >> wave.length >> wave.speed >> wave.startX >> wave.startY);
+            fields >> wave.rowSpacing;
+            valid = valid && validWave(wave);
+            waves.push_back(wave);
+        }
+        else {
+            valid = false;
+        }
+
+        if (!valid) {
+            error = textFilename + ":" + std::to_string(lineNumber) + ": cannot parse '" + line + "'";
+            return false;
+        }
+    }
+
+    // The playfield line may come after the mushrooms, so they are checked once everything is read
+    for (std::size_t i = 0; i < mushrooms.size(); ++i) {
+        if (!validMushroom(mushrooms[i], header.playfieldWidth, header.playfieldHeight)) {
+            error = textFilename + ": mushroom " + std::to_string(i + 1) + " is outside the playfield or has an invalid damage";
+            return false;
+        }
+    }
+
+    header.mushroomCount = static_cast<std::uint32_t>(mushrooms.size());
+    header.mushroomOffset = sizeof(LevelHeader);
+    header.waveCount = static_cast<std::uint32_t>(waves.size());
+    header.waveOffset = header.mushroomOffset + header.mushroomCount * sizeof(LevelMushroom);
+
+    std::ofstream output(levelFilename, std::ios::binary);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(mushrooms.data()), mushrooms.size() * sizeof(LevelMushroom));
+    output.write(reinterpret_cast<const char*>(waves.data()), waves.size() * sizeof(LevelWave));
+    if (!output) {
+        error = "cannot write " + levelFilename;
+        return false;
+    }
+    return true;
+}
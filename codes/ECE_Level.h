@@ -0,0 +1,99 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Data-driven level files. A level is a compact binary file: a fixed header (playfield
+size, spider parameters, record counts and offsets) followed by arrays of fixed-size
+mushroom and centipede wave records. ECE_Level memory-maps the file and hands out
+pointers straight into the mapping, so opening a level validates the records in place
+without copying them. convertTextLevel builds the binary file from a human-editable
+text form.
+*/
+#ifndef ECE_LEVEL_H
+#define ECE_LEVEL_H
+
+#include <cstdint>
+#include <string>
+
+// Level header values
+const std::uint32_t LEVEL_MAGIC = 0x4C564C43;  // "CLVL"
+const std::uint16_t LEVEL_VERSION = 1;
+const std::uint32_t LEVEL_MAX_CENTIPEDES = 32;  // Centipedes per wave
+const std::uint32_t LEVEL_MAX_LENGTH = 64;      // Segments per centipede, a trail holds chains of about 60
+const float LEVEL_MAX_PLAYFIELD = 4096;          // Playfield width and height in pixels, the tile map covers all of it
+
+// Spider movement parameters
+struct LevelSpider {
+    float speedX;       // Horizontal speed per tick
+    float speedY;       // Vertical speed per tick
+    float minY;         // Highest point the spider climbs to
+    float startX;       // Start position
+    float startY;
+};
+
+// One mushroom
+struct LevelMushroom {
+    float x;
+    float y;
+    std::uint32_t damage;  // 0 = healthy, 1 = damaged
+};
+
+// One centipede wave: several centipedes of the same length, one per row
+struct LevelWave {
+    std::uint32_t centipedes;  // Number of centipedes in the wave
+    std::uint32_t length;      // Segments per centipede
+    float speed;               // Horizontal speed per step
+    float startX;              // Head position of the first centipede
+    float startY;
+    float rowSpacing;          // Vertical distance between the centipedes
+};
+
+// File header, records follow at the given offsets
+struct LevelHeader {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t reserved;
+    float playfieldWidth;
+    float playfieldHeight;
+    LevelSpider spider;
+    std::uint32_t mushroomCount;
+    std::uint32_t mushroomOffset;
+    std::uint32_t waveCount;
+    std::uint32_t waveOffset;
+};
+
+// Memory-mapped level file
+class ECE_Level {
+public:
+    ECE_Level();
+    ~ECE_Level();
+    ECE_Level(const ECE_Level&) = delete;
+    ECE_Level& operator=(const ECE_Level&) = delete;
+
+    // Maps the file and validates its header, returns false with a message on failure
+    bool open(const std::string& filename, std::string& error);
+
+    // Unmaps the file
+    void close();
+
+    // Checks if a level is loaded
+    bool isOpen() const { return header != nullptr; }
+
+    // Views into the mapped file, valid until close()
+    const LevelHeader& getHeader() const { return *header; }
+    const LevelMushroom* getMushrooms() const { return mushrooms; }
+    const LevelWave* getWaves() const { return waves; }
+
+private:
+    const LevelHeader* header;
+    const LevelMushroom* mushrooms;
+    const LevelWave* waves;
+    void* mapping;             // Start of the mapped view
+    std::size_t mappingSize;   // Size of the mapped view
+};
+
+// Converts the text form of a level into the binary form, returns false with a message on failure
+bool convertTextLevel(const std::string& textFilename, const std::string& levelFilename, std::string& error);
+
+#endif // ECE_LEVEL_H
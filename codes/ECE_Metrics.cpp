@@ -0,0 +1,314 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Live metrics export through a named shared-memory segment: shm_open and mmap on
+POSIX systems, a named file mapping on Windows. Also counts heap allocations by
+replacing the global operator new, so allocations made anywhere in the game show
+up in the counters.
+*/
+#include "ECE_Metrics.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Reader retries before giving up on a busy writer
+static const int SEQLOCK_READ_RETRIES = 1000;
+
+const char* const METRIC_NAMES[METRIC_COUNT] = {
+    "frames", "frames_dropped", "ticks", "update_us", "update_us_max", "draw_us", "draw_us_max",
+    "segments", "mushrooms", "lasers", "spiders", "collision_tests", "allocations", "wave", "score",
+    "submitted", "culled"
+};
+
+std::uint64_t collisionTestCount = 0;
+
+// Relaxed atomics: allocations can come from any thread
+static std::atomic<std::uint64_t> allocationCount(0);
+static std::atomic<std::int64_t> liveAllocationCount(0);
+
+std::uint64_t getAllocationCount()
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+std::int64_t getLiveAllocationCount()
+{
+    return liveAllocationCount.load(std::memory_order_relaxed);
+}
+
+// Global allocation hooks, the array and nothrow forms forward to these
+void* operator new(std::size_t size)
+{
+    if (void* memory = std::malloc(size ? size : 1)) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        liveAllocationCount.fetch_add(1, std::memory_order_relaxed);
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    if (memory) {
+        liveAllocationCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    operator delete(memory);
+}
+
+// Working set on Windows, the second field of /proc/self/statm (resident pages) elsewhere
+std::uint64_t getResidentSetBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return counters.WorkingSetSize;
+#else
+    std::ifstream statm("/proc/self/statm");
+    std::uint64_t totalPages = 0, residentPages = 0;
+    if (!(statm >> totalPages >> residentPages)) {
+        return 0;
+    }
+    return residentPages * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+// Constructor starts unmapped
+ECE_MetricsSegment::ECE_MetricsSegment()
+    : segment(nullptr), owner(false), mappingHandle(nullptr)
+{
+}
+
+ECE_MetricsSegment::~ECE_MetricsSegment()
+{
+    close();
+}
+
+// Create the segment read-write and initialize the header, never taking over another game's segment
+bool ECE_MetricsSegment::create(const std::string& name, std::string& error)
+{
+    close();
+
+#ifdef _WIN32
+    // Mappings go away with their last handle, so an existing one always belongs to a running process
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(MetricsSegment), ("Local\\" + name).c_str());
+    if (!mapping) {
+        error = "cannot create shared memory " + name;
+        return false;
+    }
+    if (GetLastError() == ERROR_ALREADY_EXISTS) {
+        CloseHandle(mapping);
+        error = "shared memory " + name + " is already in use";
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(MetricsSegment));
+    if (!view) {
+        CloseHandle(mapping);
+        error = "cannot map shared memory " + name;
+        return false;
+    }
+    mappingHandle = mapping;
+#else
+    const std::string shmName = "/" + name;
+    int file = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (file < 0 && errno == EEXIST) {
+        // Names outlive a crashed game: only a segment whose game is gone may be removed
+        ECE_MetricsSegment existing;
+        std::string attachError;
+        if (!existing.attach(name, attachError)) {
+            error = shmName + " already exists and is not a metrics segment of this version";
+            return false;
+        }
+        if (existing.isWriterRunning()) {
+            error = shmName + " is in use by process " + std::to_string(existing.segment->writerPid);
+            return false;
+        }
+        existing.close();
+        shm_unlink(shmName.c_str());
+        file = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (file < 0) {
+        error = "cannot create shared memory " + shmName;
+        return false;
+    }
+    if (ftruncate(file, sizeof(MetricsSegment)) != 0) {
+        ::close(file);
+        shm_unlink(shmName.c_str());
+        error = "cannot size shared memory " + shmName;
+        return false;
+    }
+    void* view = mmap(nullptr, sizeof(MetricsSegment), PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    ::close(file);
+    if (view == MAP_FAILED) {
+        shm_unlink(shmName.c_str());
+        error = "cannot map shared memory " + shmName;
+        return false;
+    }
+#endif
+
+    // Counters start at zero, the header tells readers what they are looking at
+    std::memset(view, 0, sizeof(MetricsSegment));
+    segment = static_cast<MetricsSegment*>(view);
+    segment->magic = METRICS_MAGIC;
+    segment->version = METRICS_VERSION;
+    segment->counterCount = METRIC_COUNT;
+#ifdef _WIN32
+    segment->writerPid = GetCurrentProcessId();
+#else
+    segment->writerPid = static_cast<std::uint32_t>(getpid());
+#endif
+    segment->writerActive.store(1, std::memory_order_release);
+    segmentName = name;
+    owner = true;
+    return true;
+}
+
+// Map an existing segment read-only and check its header
+bool ECE_MetricsSegment::attach(const std::string& name, std::string& error)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, ("Local\\" + name).c_str());
+    if (!mapping) {
+        error = "no metrics segment named " + name;
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, sizeof(MetricsSegment));
+    if (!view) {
+        CloseHandle(mapping);
+        error = "cannot map shared memory " + name;
+        return false;
+    }
+    mappingHandle = mapping;
+#else
+    const std::string shmName = "/" + name;
+    int file = shm_open(shmName.c_str(), O_RDONLY, 0);
+    if (file < 0) {
+        error = "no metrics segment named " + shmName;
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(file, &fileStat) != 0 || static_cast<std::size_t>(fileStat.st_size) < sizeof(MetricsSegment)) {
+        ::close(file);
+        error = shmName + " is not a metrics segment";
+        return false;
+    }
+    void* view = mmap(nullptr, sizeof(MetricsSegment), PROT_READ, MAP_SHARED, file, 0);
+    ::close(file);
+    if (view == MAP_FAILED) {
+        error = "cannot map shared memory " + shmName;
+        return false;
+    }
+#endif
+
+    segment = static_cast<MetricsSegment*>(view);
+    segmentName = name;
+    owner = false;
+    if (segment->magic != METRICS_MAGIC || segment->version != METRICS_VERSION || segment->counterCount != METRIC_COUNT) {
+        error = name + " is not a metrics segment of version " + std::to_string(METRICS_VERSION);
+        close();
+        return false;
+    }
+    return true;
+}
+
+// Unmap, and remove the name if this process created it
+void ECE_MetricsSegment::close()
+{
+    if (!segment) {
+        return;
+    }
+    if (owner) {
+        segment->writerActive.store(0, std::memory_order_release);
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(segment);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    mappingHandle = nullptr;
+#else
+    munmap(segment, sizeof(MetricsSegment));
+    if (owner) {
+        shm_unlink(("/" + segmentName).c_str());
+    }
+#endif
+    segment = nullptr;
+    owner = false;
+}
+
+// The flag covers a clean exit, the process check a crash
+bool ECE_MetricsSegment::isWriterRunning() const
+{
+    if (!segment || segment->writerActive.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+#ifdef _WIN32
+    HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, segment->writerPid);
+    if (!process) {
+        return false;
+    }
+    const bool running = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return running;
+#else
+    return kill(static_cast<pid_t>(segment->writerPid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+// Odd sequence, counters, even sequence
+void ECE_MetricsSegment::publish(const MetricsSample& sample)
+{
+    if (!segment || !owner) {
+        return;
+    }
+    const std::uint32_t sequence = segment->sequence.load(std::memory_order_relaxed);
+    segment->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < METRIC_COUNT; ++i) {
+        segment->counters[i].store(sample.values[i], std::memory_order_relaxed);
+    }
+    segment->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+// Copy the counters and keep the copy only if no update started or finished meanwhile
+bool ECE_MetricsSegment::read(MetricsSample& sample) const
+{
+    if (!segment) {
+        return false;
+    }
+    for (int attempt = 0; attempt < SEQLOCK_READ_RETRIES; ++attempt) {
+        const std::uint32_t before = segment->sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;  // Writer is in the middle of an update
+        }
+        for (int i = 0; i < METRIC_COUNT; ++i) {
+            sample.values[i] = segment->counters[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (segment->sequence.load(std::memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+    return false;
+}
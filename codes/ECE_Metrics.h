@@ -0,0 +1,117 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Live metrics export. The game publishes a fixed set of counters into a named
+shared-memory segment once per frame, and an external monitor maps the same
+segment read-only. The segment is protected by a seqlock: the single writer makes
+the sequence number odd while it updates the counters and even again when it's
+done, and readers retry until they see the same even number before and after
+copying. Publishing is a handful of stores, with no I/O and no locks in the game loop.
+*/
+#ifndef ECE_METRICS_H
+#define ECE_METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Constants
+const std::uint32_t METRICS_MAGIC = 0x5254454D;    // "METR"
+const std::uint32_t METRICS_VERSION = 3;           // Bump whenever the counter list changes
+
+// Counters in the segment, in order
+enum MetricId {
+    METRIC_FRAMES,             // Frames presented since start
+    METRIC_FRAMES_DROPPED,     // Frames that took longer than a 60 Hz frame
+    METRIC_TICKS,              // Simulation ticks run, including rollback resimulation
+    METRIC_UPDATE_MICROS,      // Simulation time of the last frame
+    METRIC_UPDATE_MICROS_MAX,  // Longest simulation time of a frame
+    METRIC_DRAW_MICROS,        // Draw time of the last frame
+    METRIC_DRAW_MICROS_MAX,    // Longest draw time of a frame
+    METRIC_SEGMENTS,           // Centipede segments on the field
+    METRIC_MUSHROOMS,          // Mushrooms on the field
+    METRIC_LASERS,             // Laser blasts in flight
+    METRIC_SPIDERS,            // Spiders on the field
+    METRIC_COLLISION_TESTS,    // Collision tests performed since start
+    METRIC_ALLOCATIONS,        // Heap allocations since start
+    METRIC_WAVE,               // Wave being played
+    METRIC_SCORE,              // Player score
+    METRIC_SUBMITTED,          // Objects submitted to the renderer in the last frame
+    METRIC_CULLED,             // Objects culled or inactive in the last frame
+    METRIC_COUNT
+};
+
+// Counter names for printing, indexed by MetricId
+extern const char* const METRIC_NAMES[METRIC_COUNT];
+
+// One consistent copy of all counters
+struct MetricsSample {
+    std::uint64_t values[METRIC_COUNT];
+};
+
+// Layout of the shared-memory segment
+struct MetricsSegment {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::atomic<std::uint32_t> sequence;               // Odd while the writer is updating the counters
+    std::uint32_t counterCount;
+    std::atomic<std::uint32_t> writerActive;           // Set while the game has the segment open
+    std::uint32_t writerPid;                           // Process id of the game
+    std::atomic<std::uint64_t> counters[METRIC_COUNT];
+};
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free && std::atomic<std::uint64_t>::is_always_lock_free,
+    "Counters in shared memory must be lock-free atomics");
+
+// Collision tests performed since start, counted by the collision checks
+extern std::uint64_t collisionTestCount;
+
+// Heap allocations since start, counted by the global operator new
+std::uint64_t getAllocationCount();
+
+// Heap allocations not freed yet, operator new counts up and operator delete counts down
+std::int64_t getLiveAllocationCount();
+
+// Resident set size of the process in bytes, 0 if it can't be read
+std::uint64_t getResidentSetBytes();
+
+// A mapped metrics segment, either as the game (writer) or as a monitor (reader)
+class ECE_MetricsSegment {
+public:
+    ECE_MetricsSegment();
+    ~ECE_MetricsSegment();
+    ECE_MetricsSegment(const ECE_MetricsSegment&) = delete;
+    ECE_MetricsSegment& operator=(const ECE_MetricsSegment&) = delete;
+
+    // Creates the named segment for publishing, returns false with a message on failure. A segment
+    // left behind by a game that crashed is removed; one whose game is still running is left alone.
+    bool create(const std::string& name, std::string& error);
+
+    // Maps an existing segment read-only, returns false with a message on failure
+    bool attach(const std::string& name, std::string& error);
+
+    // Unmaps the segment, the writer also removes the name
+    void close();
+
+    // Checks if a segment is mapped
+    bool isOpen() const { return segment != nullptr; }
+
+    // Checks if the game that created the segment still has it open and is still running
+    bool isWriterRunning() const;
+
+    // Writes all counters as one update (writer only)
+    void publish(const MetricsSample& sample);
+
+    // Copies a consistent set of counters, returns false if the writer kept it busy for every retry
+    bool read(MetricsSample& sample) const;
+
+private:
+    MetricsSegment* segment;
+    std::string segmentName;
+    bool owner;                 // Created by this process
+    void* mappingHandle;        // File mapping handle on Windows
+};
+
+#endif // ECE_METRICS_H
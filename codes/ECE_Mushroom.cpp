@@ -0,0 +1,38 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Create an ECE_Mushroom class derived from the SFML::Sprite.
+The class keeps the damage state of a mushroom as an explicit field instead of
+encoding it in which texture the sprite currently points to, so the state can be
+saved, restored and compared without looking at texture addresses.
+*/
+#include "ECE_Mushroom.h"
+#include "ECE_Textures.h"
+
+// Constructor to initialize the mushroom texture, size and damage state
+ECE_Mushroom::ECE_Mushroom(const sf::Texture& healthyTexture)
+    : damage(0)
+{
+    setSpriteTexture(*this, healthyTexture);
+    setScale(0.8f, 0.8f);  // Set the size of the mushroom
+}
+
+// A healthy mushroom turns into a damaged one, a damaged mushroom is destroyed
+bool ECE_Mushroom::hit(const sf::Texture& damagedTexture)
+{
+    if (damage == 0) {
+        damage = 1;
+        setTexture(damagedTexture);  // Show the damaged mushroom
+        return false;
+    }
+    return true;  // Second hit destroys the mushroom
+}
+
+// Set the damage state and the texture that goes with it
+void ECE_Mushroom::setDamage(int newDamage, const sf::Texture& healthyTexture, const sf::Texture& damagedTexture)
+{
+    damage = newDamage;
+    setTexture(damage == 0 ? healthyTexture : damagedTexture);
+}
@@ -0,0 +1,38 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Create an ECE_Mushroom class derived from the SFML::Sprite.
+The class keeps the damage state of a mushroom as an explicit field instead of
+encoding it in which texture the sprite currently points to, so the state can be
+saved, restored and compared without looking at texture addresses.
+*/
+#ifndef ECE_MUSHROOM_H
+#define ECE_MUSHROOM_H
+
+#include <SFML/Graphics.hpp>
+
+class ECE_Mushroom : public sf::Sprite {
+public:
+    // Constructor to initialize an undamaged mushroom with the healthy texture
+    ECE_Mushroom(const sf::Texture& healthyTexture);
+
+    // Getter for the number of hits the mushroom has taken
+    int getDamage() const { return damage; }
+
+    // Checks if the mushroom has already been hit once
+    bool isDamaged() const { return damage > 0; }
+
+    // Applies one laser hit, returns true if the mushroom is destroyed and should be removed
+    bool hit(const sf::Texture& damagedTexture);
+
+    // Sets the damage state directly and applies the matching texture (used when restoring a snapshot)
+    void setDamage(int newDamage, const sf::Texture& healthyTexture, const sf::Texture& damagedTexture);
+
+private:
+    // Number of hits taken (0 = healthy, 1 = damaged)
+    int damage;
+};
+
+#endif // ECE_MUSHROOM_H
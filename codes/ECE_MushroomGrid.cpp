@@ -0,0 +1,272 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Tile-occupancy map for the optional grid-snapped mushroom mode. Rectangle queries
+turn the covered columns into one bit mask per word and scan the covered rows.
+When a row fits in a single word the rows are consecutive words, and the scan runs
+two rows at a time with SSE2. Only the few tiles whose bits are set get the exact
+bounds test, with one tile of margin so rounding at tile edges can't hide a hit.
+*/
+#include "ECE_MushroomGrid.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ECE_USE_SSE2 1
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Bits set for columns first..last of a word, both relative to the word
+static std::uint64_t columnMask(int first, int last)
+{
+    const std::uint64_t upTo = (last >= 63) ? ~std::uint64_t(0) : ((std::uint64_t(1) << (last + 1)) - 1);
+    return upTo & (~std::uint64_t(0) << first);
+}
+
+// Index of the lowest set bit, word must not be 0
+static int lowestBit(std::uint64_t word)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#elif defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int index = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+// OR of count consecutive words masked with mask, the layout when a row is a single word
+static std::uint64_t orConsecutiveWords(const std::uint64_t* words, int count, std::uint64_t mask)
+{
+    std::uint64_t result = 0;
+    int i = 0;
+#ifdef ECE_USE_SSE2
+    const __m128i mask2 = _mm_set_epi32(static_cast<int>(mask >> 32), static_cast<int>(mask),
+                                        static_cast<int>(mask >> 32), static_cast<int>(mask));
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 2 <= count; i += 2) {
+        acc = _mm_or_si128(acc, _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i)), mask2));
+    }
+    acc = _mm_or_si128(acc, _mm_unpackhi_epi64(acc, acc));
+    std::uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    result = lanes[0];
+#endif
+    for (; i < count; ++i) {
+        result |= words[i] & mask;
+    }
+    return result;
+}
+
+// Constructor starts with an empty map
+ECE_MushroomGrid::ECE_MushroomGrid()
+    : tileWidth(1), tileHeight(1), columns(0), rows(0), wordsPerRow(0), nextOrder(0)
+{
+}
+
+// Sizes the bitboards for the playfield
+void ECE_MushroomGrid::reset(float playfieldWidth, float playfieldHeight, float newTileWidth, float newTileHeight)
+{
+    tileWidth = newTileWidth;
+    tileHeight = newTileHeight;
+    columns = static_cast<int>(std::ceil(playfieldWidth / tileWidth));
+    rows = static_cast<int>(std::ceil(playfieldHeight / tileHeight));
+    wordsPerRow = (columns + 63) / 64;
+    occupied.assign(static_cast<std::size_t>(wordsPerRow) * rows, 0);
+    damaged.assign(occupied.size(), 0);
+    bounds.assign(static_cast<std::size_t>(columns) * rows, sf::FloatRect());
+    order.assign(bounds.size(), 0);
+    mushroomAt.assign(bounds.size(), std::list<ECE_Mushroom>::iterator());
+    nextOrder = 0;
+}
+
+// Marks the tile under the center of each mushroom, in list order
+void ECE_MushroomGrid::rebuild(std::list<ECE_Mushroom>& mushrooms)
+{
+    std::fill(occupied.begin(), occupied.end(), 0);
+    std::fill(damaged.begin(), damaged.end(), 0);
+    nextOrder = 0;
+
+    for (auto mushroomIt = mushrooms.begin(); mushroomIt != mushrooms.end(); ++mushroomIt) {
+        const sf::FloatRect mushroomBounds = mushroomIt->getGlobalBounds();
+        int column, row;
+        if (tileAt(sf::Vector2f(mushroomBounds.left + mushroomBounds.width / 2, mushroomBounds.top + mushroomBounds.height / 2), column, row)) {
+            place(column, row, mushroomIt);
+        }
+    }
+}
+
+// Every mushroom must land on an occupied tile, and every occupied tile must get a mushroom
+bool ECE_MushroomGrid::relink(std::list<ECE_Mushroom>& mushrooms)
+{
+    std::size_t linked = 0;
+    for (auto mushroomIt = mushrooms.begin(); mushroomIt != mushrooms.end(); ++mushroomIt) {
+        const sf::FloatRect mushroomBounds = mushroomIt->getGlobalBounds();
+        int column, row;
+        if (!tileAt(sf::Vector2f(mushroomBounds.left + mushroomBounds.width / 2, mushroomBounds.top + mushroomBounds.height / 2), column, row) ||
+            !isOccupied(column, row)) {
+            return false;
+        }
+        mushroomAt[static_cast<std::size_t>(row) * columns + column] = mushroomIt;
+        linked++;
+    }
+
+    std::size_t occupiedTiles = 0;
+    for (std::uint64_t word : occupied) {
+        for (; word != 0; word &= word - 1) {
+            occupiedTiles++;
+        }
+    }
+    return linked == occupiedTiles;
+}
+
+// Tile containing a point
+bool ECE_MushroomGrid::tileAt(const sf::Vector2f& point, int& column, int& row) const
+{
+    if (point.x < 0 || point.y < 0) {
+        return false;
+    }
+    column = static_cast<int>(point.x / tileWidth);
+    row = static_cast<int>(point.y / tileHeight);
+    return column < columns && row < rows;
+}
+
+// Top-left corner of a tile
+sf::Vector2f ECE_MushroomGrid::tilePosition(int column, int row) const
+{
+    return sf::Vector2f(column * tileWidth, row * tileHeight);
+}
+
+// Sets the occupied bit and the damaged bit, and records the sprite bounds and list position
+void ECE_MushroomGrid::place(int column, int row, std::list<ECE_Mushroom>::iterator mushroom)
+{
+    const std::size_t word = static_cast<std::size_t>(row) * wordsPerRow + column / 64;
+    const std::uint64_t bit = std::uint64_t(1) << (column % 64);
+    occupied[word] |= bit;
+    if (mushroom->isDamaged()) {
+        damaged[word] |= bit;
+    }
+    else {
+        damaged[word] &= ~bit;
+    }
+
+    const std::size_t tile = static_cast<std::size_t>(row) * columns + column;
+    bounds[tile] = mushroom->getGlobalBounds();
+    order[tile] = nextOrder++;
+    mushroomAt[tile] = mushroom;
+}
+
+// Sets the damaged bit of an occupied tile
+void ECE_MushroomGrid::setDamaged(int column, int row)
+{
+    damaged[static_cast<std::size_t>(row) * wordsPerRow + column / 64] |= std::uint64_t(1) << (column % 64);
+}
+
+// Clears both bits of a tile
+void ECE_MushroomGrid::remove(int column, int row)
+{
+    const std::size_t word = static_cast<std::size_t>(row) * wordsPerRow + column / 64;
+    const std::uint64_t bit = std::uint64_t(1) << (column % 64);
+    occupied[word] &= ~bit;
+    damaged[word] &= ~bit;
+}
+
+// Tests one bit of a bitboard
+bool ECE_MushroomGrid::testBit(const std::vector<std::uint64_t>& bits, int column, int row) const
+{
+    if (column < 0 || row < 0 || column >= columns || row >= rows) {
+        return false;
+    }
+    return (bits[static_cast<std::size_t>(row) * wordsPerRow + column / 64] >> (column % 64)) & 1;
+}
+
+// Tiles a rectangle covers, plus one on every side for mushrooms reaching over a tile edge
+bool ECE_MushroomGrid::tileRange(const sf::FloatRect& rect, int& firstColumn, int& firstRow, int& lastColumn, int& lastRow) const
+{
+    if (rect.width <= 0 || rect.height <= 0) {
+        return false;
+    }
+    firstColumn = std::max(0, static_cast<int>(std::floor(rect.left / tileWidth)) - 1);
+    firstRow = std::max(0, static_cast<int>(std::floor(rect.top / tileHeight)) - 1);
+    lastColumn = std::min(columns - 1, static_cast<int>(std::floor((rect.left + rect.width) / tileWidth)) + 1);
+    lastRow = std::min(rows - 1, static_cast<int>(std::floor((rect.top + rect.height) / tileHeight)) + 1);
+    return firstColumn <= lastColumn && firstRow <= lastRow;
+}
+
+// Walk the set bits in the range and test the recorded bounds of each
+template <typename Visit>
+void ECE_MushroomGrid::forEachHit(const sf::FloatRect& rect, Visit visit) const
+{
+    int firstColumn, firstRow, lastColumn, lastRow;
+    if (!tileRange(rect, firstColumn, firstRow, lastColumn, lastRow)) {
+        return;
+    }
+
+    for (int word = firstColumn / 64; word <= lastColumn / 64; ++word) {
+        const std::uint64_t mask = columnMask(std::max(firstColumn - word * 64, 0), std::min(lastColumn - word * 64, 63));
+
+        // Most queries cover no mushroom at all: rule that out with one pass over the rows
+        if (wordsPerRow == 1 && orConsecutiveWords(&occupied[firstRow], lastRow - firstRow + 1, mask) == 0) {
+            continue;
+        }
+
+        for (int row = firstRow; row <= lastRow; ++row) {
+            std::uint64_t bits = occupied[static_cast<std::size_t>(row) * wordsPerRow + word] & mask;
+            while (bits != 0) {
+                const std::size_t tile = static_cast<std::size_t>(row) * columns + word * 64 + lowestBit(bits);
+                if (bounds[tile].intersects(rect) && !visit(tile)) {
+                    return;
+                }
+                bits &= bits - 1;  // Clear the lowest set bit
+            }
+        }
+    }
+}
+
+// Stop at the first mushroom that overlaps
+bool ECE_MushroomGrid::anyInRect(const sf::FloatRect& rect) const
+{
+    bool found = false;
+    forEachHit(rect, [&](std::size_t) {
+        found = true;
+        return false;
+    });
+    return found;
+}
+
+// Of the overlapped mushrooms, take the one that comes first in the list
+bool ECE_MushroomGrid::findInRect(const sf::FloatRect& rect, int& column, int& row) const
+{
+    std::size_t first = bounds.size();
+    forEachHit(rect, [&](std::size_t tile) {
+        if (first == bounds.size() || order[tile] < order[first]) {
+            first = tile;
+        }
+        return true;
+    });
+    if (first == bounds.size()) {
+        return false;
+    }
+    column = static_cast<int>(first % columns);
+    row = static_cast<int>(first / columns);
+    return true;
+}
+
+// The tile keeps its mushroom's list position, so no walk is needed
+std::list<ECE_Mushroom>::iterator ECE_MushroomGrid::findMushroom(int column, int row) const
+{
+    return mushroomAt[static_cast<std::size_t>(row) * columns + column];
+}
@@ -0,0 +1,94 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Tile-occupancy map for the optional grid-snapped mushroom mode. Mushrooms sit on
+square tiles and the map keeps two bitboards, one for occupied tiles and one for
+damaged tiles, one bit per tile in row-major 64-bit words. Collision queries test
+the bits of the tiles a rectangle covers instead of intersecting it with every
+mushroom sprite, so their cost doesn't depend on how many mushrooms are on the field.
+The mushroom sprites stay in their list for drawing and snapshots; the map mirrors it.
+Occupied tiles also keep the sprite bounds and the list order of their mushroom, so a
+query gives exactly the answer the list walk would: same edges, same first mushroom.
+They keep the mushroom's position in the list too, so a hit reaches its sprite without
+walking the list.
+*/
+#ifndef ECE_MUSHROOMGRID_H
+#define ECE_MUSHROOMGRID_H
+
+#include <cstdint>
+#include <list>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "ECE_Mushroom.h"
+
+class ECE_MushroomGrid {
+public:
+    ECE_MushroomGrid();
+
+    // Sizes the map for the playfield with tiles the size of a mushroom sprite and clears every tile
+    void reset(float playfieldWidth, float playfieldHeight, float newTileWidth, float newTileHeight);
+
+    // Clears every tile and marks the tiles of the mushrooms in the list
+    void rebuild(std::list<ECE_Mushroom>& mushrooms);
+
+    // Finds the tile containing a point, returns false outside the playfield
+    bool tileAt(const sf::Vector2f& point, int& column, int& row) const;
+
+    // Top-left corner of a tile, where a snapped mushroom sprite is placed
+    sf::Vector2f tilePosition(int column, int row) const;
+
+    // Points the tiles at the mushrooms of a list that replaced the one the map was built for (a snapshot
+    // restore makes new list nodes), keeping the tile state. False if the list and the occupied tiles disagree.
+    bool relink(std::list<ECE_Mushroom>& mushrooms);
+
+    // Tile state
+    bool isOccupied(int column, int row) const { return testBit(occupied, column, row); }
+    bool isDamaged(int column, int row) const { return testBit(damaged, column, row); }
+
+    // Marks a tile as holding a mushroom of the list, appended after all others in list order.
+    // The mushroom must be removed from the tile before it is erased from the list.
+    void place(int column, int row, std::list<ECE_Mushroom>::iterator mushroom);
+    void setDamaged(int column, int row);
+    void remove(int column, int row);
+
+    // Checks if the rectangle overlaps any mushroom
+    bool anyInRect(const sf::FloatRect& rect) const;
+
+    // Finds the tile of the overlapped mushroom that comes first in list order
+    bool findInRect(const sf::FloatRect& rect, int& column, int& row) const;
+
+    // Gets the mushroom placed on an occupied tile
+    std::list<ECE_Mushroom>::iterator findMushroom(int column, int row) const;
+
+    // Getters for the map size
+    float getTileWidth() const { return tileWidth; }
+    float getTileHeight() const { return tileHeight; }
+    int getColumns() const { return columns; }
+    int getRows() const { return rows; }
+
+private:
+    // Clamps the tiles a rectangle may touch to the map, returns false if none are
+    bool tileRange(const sf::FloatRect& rect, int& firstColumn, int& firstRow, int& lastColumn, int& lastRow) const;
+
+    // Calls visit(tile index) for every occupied tile in the range whose mushroom overlaps rect, stops when it returns false
+    template <typename Visit>
+    void forEachHit(const sf::FloatRect& rect, Visit visit) const;
+
+    bool testBit(const std::vector<std::uint64_t>& bits, int column, int row) const;
+
+    float tileWidth;
+    float tileHeight;
+    int columns;
+    int rows;
+    int wordsPerRow;                      // 64 tiles per word
+    std::vector<std::uint64_t> occupied;  // One bit per tile holding a mushroom
+    std::vector<std::uint64_t> damaged;   // One bit per tile holding a damaged mushroom
+    std::vector<sf::FloatRect> bounds;    // Sprite bounds of the mushroom on each occupied tile
+    std::vector<std::uint32_t> order;     // Position of that mushroom in list order
+    std::vector<std::list<ECE_Mushroom>::iterator> mushroomAt;  // That mushroom in its list
+    std::uint32_t nextOrder;
+};
+
+#endif // ECE_MUSHROOMGRID_H
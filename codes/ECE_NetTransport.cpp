@@ -0,0 +1,175 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Pluggable packet transports for the two-player mode. ECE_NetTransport adds
+configurable artificial latency and packet loss on the sending side, so both the
+in-process ECE_LoopbackTransport and the localhost ECE_UdpTransport can be used to
+test bad network conditions on one machine.
+*/
+#include "ECE_NetTransport.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// Largest packet the UDP transport will receive
+static const int MAX_PACKET_SIZE = 1024;
+
+// Set the artificial latency and loss rate
+void ECE_NetTransport::setConditions(int latencyMs, float newLossRate)
+{
+    latency = std::chrono::milliseconds(latencyMs);
+    lossRate = newLossRate;
+}
+
+// Drop the packet with the configured probability, otherwise queue it until it is due
+void ECE_NetTransport::send(const Packet& packet)
+{
+    packetsSent++;
+    if (lossRate > 0 && std::uniform_real_distribution<float>(0, 1)(lossGen) < lossRate) {
+        packetsDropped++;
+        return;
+    }
+    delayed.push_back({ Clock::now() + latency, packet });
+    flush();
+}
+
+// Flush due packets, then read one from the link
+bool ECE_NetTransport::receive(Packet& packet)
+{
+    flush();
+    if (receiveNow(packet)) {
+        packetsReceived++;
+        return true;
+    }
+    return false;
+}
+
+// Send every delayed packet whose latency has elapsed, in order
+void ECE_NetTransport::flush()
+{
+    const Clock::time_point now = Clock::now();
+    while (!delayed.empty() && delayed.front().due <= now) {
+        sendNow(delayed.front().packet);
+        delayed.pop_front();
+    }
+}
+
+// Connect two endpoints through a pair of shared queues
+void ECE_LoopbackTransport::createPair(std::unique_ptr<ECE_LoopbackTransport>& first, std::unique_ptr<ECE_LoopbackTransport>& second)
+{
+    first.reset(new ECE_LoopbackTransport());
+    second.reset(new ECE_LoopbackTransport());
+    first->outbox = second->inbox = std::make_shared<std::deque<Packet>>();
+    second->outbox = first->inbox = std::make_shared<std::deque<Packet>>();
+}
+
+// Put the packet in the other endpoint's inbox
+void ECE_LoopbackTransport::sendNow(const Packet& packet)
+{
+    outbox->push_back(packet);
+}
+
+// Take the oldest packet from the inbox
+bool ECE_LoopbackTransport::receiveNow(Packet& packet)
+{
+    if (inbox->empty()) {
+        return false;
+    }
+    packet.swap(inbox->front());
+    inbox->pop_front();
+    return true;
+}
+
+// Constructor starts with a closed socket
+ECE_UdpTransport::ECE_UdpTransport()
+    : socketHandle(-1), remotePort(0)
+{
+}
+
+// Close the socket if it is open
+ECE_UdpTransport::~ECE_UdpTransport()
+{
+    if (socketHandle != -1) {
+#ifdef _WIN32
+        closesocket(static_cast<SOCKET>(socketHandle));
+        WSACleanup();
+#else
+        close(static_cast<int>(socketHandle));
+#endif
+    }
+}
+
+// Create a non-blocking socket bound to the local port on 127.0.0.1
+bool ECE_UdpTransport::open(unsigned short localPort, unsigned short peerPort)
+{
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        return false;
+    }
+    SOCKET handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (handle == INVALID_SOCKET) {
+        WSACleanup();
+        return false;
+    }
+    u_long nonBlocking = 1;
+    ioctlsocket(handle, FIONBIO, &nonBlocking);
+#else
+    int handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (handle < 0) {
+        return false;
+    }
+    fcntl(handle, F_SETFL, fcntl(handle, F_GETFL, 0) | O_NONBLOCK);
+#endif
+    socketHandle = static_cast<std::intptr_t>(handle);
+    remotePort = peerPort;
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(localPort);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return bind(handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+}
+
+// Send the packet to the peer port on localhost
+void ECE_UdpTransport::sendNow(const Packet& packet)
+{
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(remotePort);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+#ifdef _WIN32
+    sendto(static_cast<SOCKET>(socketHandle), reinterpret_cast<const char*>(packet.data()), static_cast<int>(packet.size()), 0,
+        reinterpret_cast<sockaddr*>(&address), sizeof(address));
+#else
+    sendto(static_cast<int>(socketHandle), packet.data(), packet.size(), 0,
+        reinterpret_cast<sockaddr*>(&address), sizeof(address));
+#endif
+}
+
+// Read one datagram if one is waiting
+bool ECE_UdpTransport::receiveNow(Packet& packet)
+{
+    packet.resize(MAX_PACKET_SIZE);
+#ifdef _WIN32
+    int received = recv(static_cast<SOCKET>(socketHandle), reinterpret_cast<char*>(packet.data()), MAX_PACKET_SIZE, 0);
+#else
+    long received = recv(static_cast<int>(socketHandle), packet.data(), MAX_PACKET_SIZE, 0);
+#endif
+    if (received <= 0) {
+        packet.clear();
+        return false;
+    }
+    packet.resize(static_cast<std::size_t>(received));
+    return true;
+}
@@ -0,0 +1,102 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Pluggable packet transports for the two-player mode. ECE_NetTransport adds
+configurable artificial latency and packet loss on the sending side, so both the
+in-process ECE_LoopbackTransport and the localhost ECE_UdpTransport can be used to
+test bad network conditions on one machine.
+*/
+#ifndef ECE_NETTRANSPORT_H
+#define ECE_NETTRANSPORT_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <random>
+#include <vector>
+
+typedef std::vector<std::uint8_t> Packet;
+
+// Base class: delays and drops outgoing packets, the derived class moves the bytes
+class ECE_NetTransport {
+public:
+    virtual ~ECE_NetTransport() {}
+
+    // Sets the artificial one-way latency and the fraction of packets to drop (0..1)
+    void setConditions(int latencyMs, float lossRate);
+
+    // Queues a packet, it is handed to the link once its latency has elapsed
+    void send(const Packet& packet);
+
+    // Flushes due packets and returns the next received one, false if none is waiting
+    bool receive(Packet& packet);
+
+    // Counters for the metrics report
+    int getPacketsSent() const { return packetsSent; }
+    int getPacketsDropped() const { return packetsDropped; }
+    int getPacketsReceived() const { return packetsReceived; }
+
+protected:
+    // Hands a packet to the underlying link
+    virtual void sendNow(const Packet& packet) = 0;
+
+    // Takes one packet from the underlying link, false if none is waiting
+    virtual bool receiveNow(Packet& packet) = 0;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    // Sends every delayed packet whose time has come
+    void flush();
+
+    struct DelayedPacket {
+        Clock::time_point due;
+        Packet packet;
+    };
+
+    std::deque<DelayedPacket> delayed;          // Packets waiting for their latency to elapse
+    std::chrono::milliseconds latency{ 0 };     // Artificial one-way latency
+    float lossRate = 0.0f;                      // Fraction of packets dropped
+    std::mt19937 lossGen{ 6122 };               // Own generator so the game RNG is untouched
+    int packetsSent = 0;
+    int packetsDropped = 0;
+    int packetsReceived = 0;
+};
+
+// In-process link: two endpoints created together share a pair of queues
+class ECE_LoopbackTransport : public ECE_NetTransport {
+public:
+    // Creates two connected endpoints
+    static void createPair(std::unique_ptr<ECE_LoopbackTransport>& first, std::unique_ptr<ECE_LoopbackTransport>& second);
+
+protected:
+    void sendNow(const Packet& packet) override;
+    bool receiveNow(Packet& packet) override;
+
+private:
+    std::shared_ptr<std::deque<Packet>> outbox;  // Read by the other endpoint
+    std::shared_ptr<std::deque<Packet>> inbox;   // Written by the other endpoint
+};
+
+// Non-blocking UDP socket bound to localhost and sending to a fixed peer port
+class ECE_UdpTransport : public ECE_NetTransport {
+public:
+    ECE_UdpTransport();
+    ~ECE_UdpTransport();
+
+    // Binds to 127.0.0.1:localPort and targets 127.0.0.1:remotePort, returns false on failure
+    bool open(unsigned short localPort, unsigned short remotePort);
+
+protected:
+    void sendNow(const Packet& packet) override;
+    bool receiveNow(Packet& packet) override;
+
+private:
+    std::intptr_t socketHandle;    // Native socket, -1 when closed
+    unsigned short remotePort;     // Peer port on localhost
+};
+
+#endif // ECE_NETTRANSPORT_H
@@ -0,0 +1,30 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Compact per-tick player input. The state of the movement and fire keys is packed
+into one byte so inputs can be recorded, compared and sent over the network, and the
+simulation can be stepped from recorded inputs instead of the live keyboard.
+*/
+#include "ECE_PlayerInput.h"
+
+// Pack the pressed keys into one input byte
+PlayerInput sampleKeyboard(const ECE_KeyBindings& keys)
+{
+    PlayerInput input = 0;
+    if (sf::Keyboard::isKeyPressed(keys.left)) input |= INPUT_LEFT;
+    if (sf::Keyboard::isKeyPressed(keys.right)) input |= INPUT_RIGHT;
+    if (sf::Keyboard::isKeyPressed(keys.up)) input |= INPUT_UP;
+    if (sf::Keyboard::isKeyPressed(keys.down)) input |= INPUT_DOWN;
+    if (sf::Keyboard::isKeyPressed(keys.fire)) input |= INPUT_FIRE;
+    return input;
+}
+
+// Fire every tick and change horizontal direction every 1500 ticks
+PlayerInput scriptedInput(long long tick)
+{
+    PlayerInput input = INPUT_FIRE;
+    input |= ((tick / 1500) % 2 == 0) ? INPUT_LEFT : INPUT_RIGHT;
+    return input;
+}
@@ -0,0 +1,45 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Compact per-tick player input. The state of the movement and fire keys is packed
+into one byte so inputs can be recorded, compared and sent over the network, and the
+simulation can be stepped from recorded inputs instead of the live keyboard.
+*/
+#ifndef ECE_PLAYERINPUT_H
+#define ECE_PLAYERINPUT_H
+
+#include <SFML/Window.hpp>
+#include <cstdint>
+
+// One byte of input per player per tick
+typedef std::uint8_t PlayerInput;
+
+// Bits of a PlayerInput
+const PlayerInput INPUT_LEFT = 1 << 0;
+const PlayerInput INPUT_RIGHT = 1 << 1;
+const PlayerInput INPUT_UP = 1 << 2;
+const PlayerInput INPUT_DOWN = 1 << 3;
+const PlayerInput INPUT_FIRE = 1 << 4;
+
+// Keyboard bindings for one player
+struct ECE_KeyBindings {
+    sf::Keyboard::Key left;
+    sf::Keyboard::Key right;
+    sf::Keyboard::Key up;
+    sf::Keyboard::Key down;
+    sf::Keyboard::Key fire;
+};
+
+// Arrow keys and space for player one, WASD and left control for player two
+const ECE_KeyBindings PLAYER_ONE_KEYS = { sf::Keyboard::Left, sf::Keyboard::Right, sf::Keyboard::Up, sf::Keyboard::Down, sf::Keyboard::Space };
+const ECE_KeyBindings PLAYER_TWO_KEYS = { sf::Keyboard::A, sf::Keyboard::D, sf::Keyboard::W, sf::Keyboard::S, sf::Keyboard::LControl };
+
+// Reads the current keyboard state for the given bindings
+PlayerInput sampleKeyboard(const ECE_KeyBindings& keys);
+
+// Deterministic autoplay input for headless runs: keeps firing and sweeps left and right
+PlayerInput scriptedInput(long long tick);
+
+#endif // ECE_PLAYERINPUT_H
@@ -0,0 +1,33 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Random number generator for the game field. It is a Mersenne Twister that remembers
+its seed and counts the numbers drawn from it, so its state can be saved as those two
+values (12 bytes) instead of the engine's full text state, and rebuilt by reseeding
+and skipping the same number of draws.
+*/
+#include "ECE_Random.h"
+
+// Constructor seeds the engine with no draws taken
+ECE_Random::ECE_Random(result_type seed)
+    : engine(seed), seedValue(seed), draws(0)
+{
+}
+
+// A new seed starts a new count
+void ECE_Random::seed(result_type value)
+{
+    engine.seed(value);
+    seedValue = value;
+    draws = 0;
+}
+
+// Discarding is the same as drawing and ignoring the numbers
+void ECE_Random::restore(result_type value, std::uint64_t drawCount)
+{
+    seed(value);
+    engine.discard(drawCount);
+    draws = drawCount;
+}
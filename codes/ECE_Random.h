@@ -0,0 +1,52 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Random number generator for the game field. It is a Mersenne Twister that remembers
+its seed and counts the numbers drawn from it, so its state can be saved as those two
+values (12 bytes) instead of the engine's full text state, and rebuilt by reseeding
+and skipping the same number of draws.
+*/
+#ifndef ECE_RANDOM_H
+#define ECE_RANDOM_H
+
+#include <cstdint>
+#include <random>
+
+// Drop-in for std::mt19937 wherever a uniform random bit generator is expected
+class ECE_Random {
+public:
+    typedef std::mt19937::result_type result_type;
+
+    // Constructor seeds the engine
+    explicit ECE_Random(result_type seed = std::mt19937::default_seed);
+
+    // Range of the generated numbers
+    static constexpr result_type min() { return std::mt19937::min(); }
+    static constexpr result_type max() { return std::mt19937::max(); }
+
+    // Draws the next number
+    result_type operator()()
+    {
+        draws++;
+        return engine();
+    }
+
+    // Restarts the sequence from a seed
+    void seed(result_type value);
+
+    // Rebuilds a saved state: reseeds and skips the numbers already drawn
+    void restore(result_type value, std::uint64_t drawCount);
+
+    // Getters for the saved state
+    result_type getSeed() const { return seedValue; }
+    std::uint64_t getDraws() const { return draws; }
+
+private:
+    std::mt19937 engine;
+    result_type seedValue;
+    std::uint64_t draws;
+};
+
+#endif // ECE_RANDOM_H
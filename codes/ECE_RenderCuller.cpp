@@ -0,0 +1,39 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+View culling for the scene draw: visible area of a view and per-frame counts.
+*/
+#include "ECE_RenderCuller.h"
+
+// Constructor starts with an empty frame
+ECE_RenderCuller::ECE_RenderCuller()
+    : submitted(0), culled(0)
+{
+}
+
+// Reset the counts for a new frame
+void ECE_RenderCuller::begin(const sf::FloatRect& area)
+{
+    visibleArea = area;
+    submitted.store(0, std::memory_order_relaxed);
+    culled.store(0, std::memory_order_relaxed);
+}
+
+// Objects touching the visible area are submitted, the rest are culled
+bool ECE_RenderCuller::isVisible(const sf::FloatRect& bounds)
+{
+    if (visibleArea.intersects(bounds)) {
+        count(submitted);
+        return true;
+    }
+    count(culled);
+    return false;
+}
+
+// Map the view's normalized corners back into the world
+sf::FloatRect ECE_RenderCuller::getViewArea(const sf::View& view)
+{
+    return view.getInverseTransform().transformRect(sf::FloatRect(-1, -1, 2, 2));
+}
@@ -0,0 +1,55 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+View culling for the scene draw. Each frame starts from the area the target's view
+shows; objects whose bounds don't intersect it, and pooled entities that aren't
+active, are skipped before they reach the renderer. The culler counts what was
+submitted and what was culled so the counts can be reported per frame. The counts
+are only written by the drawing thread but may be read by another one for metrics.
+*/
+#ifndef ECE_RENDERCULLER_H
+#define ECE_RENDERCULLER_H
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <cstdint>
+
+class ECE_RenderCuller {
+public:
+    ECE_RenderCuller();
+
+    // Starts a frame: sets the visible area and clears the counts
+    void begin(const sf::FloatRect& area);
+
+    // Checks if an object with these bounds is visible and counts it as submitted or culled
+    bool isVisible(const sf::FloatRect& bounds);
+
+    // Counts an object that was skipped without a bounds test (an inactive pooled entity)
+    void skip() { count(culled); }
+
+    // Counts an object drawn without a bounds test (a cached layer covering the whole field)
+    void submit() { count(submitted); }
+
+    // Getters for the current frame
+    const sf::FloatRect& getVisibleArea() const { return visibleArea; }
+    std::uint64_t getSubmitted() const { return submitted.load(std::memory_order_relaxed); }
+    std::uint64_t getCulled() const { return culled.load(std::memory_order_relaxed); }
+
+    // World-space rectangle a view shows, the bounding box when it's rotated
+    static sf::FloatRect getViewArea(const sf::View& view);
+
+private:
+    // Single writer, so a plain load and store is enough
+    static void count(std::atomic<std::uint64_t>& counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    sf::FloatRect visibleArea;
+    std::atomic<std::uint64_t> submitted;
+    std::atomic<std::uint64_t> culled;
+};
+
+#endif // ECE_RENDERCULLER_H
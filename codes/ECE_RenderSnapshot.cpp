@@ -0,0 +1,64 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Render snapshot sprites and the triple buffer that hands snapshots from the
+simulation thread to the render thread.
+*/
+#include "ECE_RenderSnapshot.h"
+
+// Copy the parts of the sprite that affect how it's drawn
+RenderSprite makeRenderSprite(const sf::Sprite& sprite, std::uint8_t texture)
+{
+    RenderSprite data;
+    data.texture = texture;
+    data.color = sprite.getColor();
+    data.textureRect = sprite.getTextureRect();
+    data.position = sprite.getPosition();
+    data.origin = sprite.getOrigin();
+    data.scale = sprite.getScale();
+    data.rotation = sprite.getRotation();
+    return data;
+}
+
+// Reuse one sprite for every snapshot sprite
+void applyRenderSprite(sf::Sprite& sprite, const RenderSprite& data, const sf::Texture& texture)
+{
+    sprite.setTexture(texture);
+    sprite.setTextureRect(data.textureRect);
+    sprite.setColor(data.color);
+    sprite.setOrigin(data.origin);
+    sprite.setPosition(data.position);
+    sprite.setScale(data.scale);
+    sprite.setRotation(data.rotation);
+}
+
+// Constructor reserves the sprite storage of every slot
+ECE_RenderSnapshotBuffer::ECE_RenderSnapshotBuffer()
+    : middle(1), backIndex(2), frontIndex(0)
+{
+    for (RenderSnapshot& slot : slots) {
+        slot.sprites.reserve(MAX_RENDER_SPRITES);
+        slot.hudIndex = 0;
+        slot.tick = 0;
+        slot.score = 0;
+        slot.wave = 0;
+        slot.ended = false;
+    }
+}
+
+// Release the filled slot and take the old middle one as the next back slot
+void ECE_RenderSnapshotBuffer::publish()
+{
+    backIndex = middle.exchange(static_cast<std::uint8_t>(backIndex | NEW_BIT), std::memory_order_acq_rel) & INDEX_MASK;
+}
+
+// Swap in the middle slot only if the writer published since the last call
+const RenderSnapshot& ECE_RenderSnapshotBuffer::acquire()
+{
+    if (middle.load(std::memory_order_relaxed) & NEW_BIT) {
+        frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+    return slots[frontIndex];
+}
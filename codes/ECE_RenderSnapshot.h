@@ -0,0 +1,76 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Render snapshots for running the simulation on its own thread. After each tick the
+simulation copies what the frame needs (sprite transforms, texture ids and the HUD
+values) into a snapshot and publishes it through a lock-free triple buffer. The
+render thread always takes the newest published snapshot and never sees game state
+that is being changed. A snapshot isn't modified once it has been published.
+*/
+#ifndef ECE_RENDERSNAPSHOT_H
+#define ECE_RENDERSNAPSHOT_H
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Constants
+const std::size_t MAX_RENDER_SPRITES = 512;   // Sprites reserved per snapshot so publishing doesn't allocate
+
+// One sprite as the renderer needs it
+struct RenderSprite {
+    std::uint8_t texture;      // Index into the game's texture table
+    sf::Color color;
+    sf::IntRect textureRect;
+    sf::Vector2f position;
+    sf::Vector2f origin;
+    sf::Vector2f scale;
+    float rotation;
+};
+
+// Everything one frame shows
+struct RenderSnapshot {
+    std::vector<RenderSprite> sprites;  // In draw order
+    std::size_t hudIndex;               // The score text is drawn before this sprite
+    std::uint64_t tick;                 // Simulation tick the snapshot was taken after
+    int score;
+    int wave;
+    bool ended;                         // The game ended on this tick
+};
+
+// Copies a sprite's transform and texture rectangle
+RenderSprite makeRenderSprite(const sf::Sprite& sprite, std::uint8_t texture);
+
+// Sets up a sprite to draw a snapshot sprite with the given texture
+void applyRenderSprite(sf::Sprite& sprite, const RenderSprite& data, const sf::Texture& texture);
+
+// Triple buffer with one writer and one reader: the writer fills the back slot and swaps it
+// with the middle one, the reader swaps the middle slot with its front slot when it is newer.
+// Neither side waits for the other.
+class ECE_RenderSnapshotBuffer {
+public:
+    ECE_RenderSnapshotBuffer();
+
+    // Writer: the slot to fill, the reader can't see it until publish()
+    RenderSnapshot& beginWrite() { return slots[backIndex]; }
+
+    // Writer: hands the filled slot to the reader
+    void publish();
+
+    // Reader: newest published snapshot, the previous one again if nothing new was published
+    const RenderSnapshot& acquire();
+
+private:
+    static const std::uint8_t INDEX_MASK = 3;
+    static const std::uint8_t NEW_BIT = 4;     // Set on the middle slot when it holds an unread snapshot
+
+    RenderSnapshot slots[3];
+    std::atomic<std::uint8_t> middle;          // Index of the middle slot and NEW_BIT
+    std::uint8_t backIndex;                    // Owned by the writer
+    std::uint8_t frontIndex;                   // Owned by the reader
+};
+
+#endif // ECE_RENDERSNAPSHOT_H
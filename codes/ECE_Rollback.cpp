@@ -0,0 +1,167 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Rollback session for the two-player mode. Every tick the local input is applied
+right away and the remote input is predicted (the last confirmed remote input is
+repeated). When the real remote input arrives and differs from the prediction, the
+session restores the snapshot taken before the mispredicted tick and re-simulates
+up to the present. The game plugs in through three callbacks: save, load and step.
+*/
+#include "ECE_Rollback.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+// Packet layout: session id (2 bytes), ack tick (4 bytes), first tick (4 bytes), count (1 byte), inputs
+static const std::size_t PACKET_HEADER_SIZE = 11;
+static const int MAX_INPUTS_PER_PACKET = 64;
+
+// Constructor to set up the input history and snapshot ring buffers
+ECE_RollbackSession::ECE_RollbackSession(ECE_NetTransport& transport, int localPlayer, std::uint16_t sessionId,
+    SaveFunction save, LoadFunction load, StepFunction step)
+    : transport(transport), localPlayer(localPlayer), sessionId(sessionId),
+      save(save), load(load), step(step),
+      currentFrame(0), remoteConfirmed(-1), remoteAcked(-1), firstIncorrect(-1),
+      localInputs(INPUT_HISTORY, 0), remoteInputs(INPUT_HISTORY, 0), predictedInputs(INPUT_HISTORY, 0),
+      snapshots(MAX_ROLLBACK_FRAMES + 1)
+{
+}
+
+// One tick: receive, correct, simulate, send
+bool ECE_RollbackSession::advance(PlayerInput localInput)
+{
+    receiveRemoteInput();
+
+    if (firstIncorrect >= 0) {
+        rollback();
+    }
+
+    // Don't run further ahead than a rollback could correct
+    if (currentFrame - remoteConfirmed > MAX_ROLLBACK_FRAMES) {
+        metrics.stalls++;
+        sendLocalInput();
+        return false;
+    }
+
+    localInputs[currentFrame % INPUT_HISTORY] = localInput;
+    simulate(currentFrame);
+    currentFrame++;
+    metrics.ticks++;
+
+    sendLocalInput();
+    return true;
+}
+
+// Read all waiting packets and compare the confirmed inputs against what was predicted
+void ECE_RollbackSession::receiveRemoteInput()
+{
+    while (transport.receive(packetBuffer)) {
+        if (packetBuffer.size() < PACKET_HEADER_SIZE) {
+            continue;
+        }
+
+        std::uint16_t packetSession = 0;
+        std::int32_t ack = 0, first = 0;
+        std::uint8_t count = 0;
+        std::memcpy(&packetSession, packetBuffer.data(), 2);
+        std::memcpy(&ack, packetBuffer.data() + 2, 4);
+        std::memcpy(&first, packetBuffer.data() + 6, 4);
+        std::memcpy(&count, packetBuffer.data() + 10, 1);
+
+        // Ignore packets from an earlier round or with a truncated payload
+        if (packetSession != sessionId || packetBuffer.size() < PACKET_HEADER_SIZE + count) {
+            continue;
+        }
+
+        remoteAcked = std::max(remoteAcked, static_cast<int>(ack));
+
+        for (int i = 0; i < count; ++i) {
+            const int frame = first + i;
+            if (frame != remoteConfirmed + 1) {
+                continue;  // Already known, or a gap that a later packet will fill
+            }
+
+            const PlayerInput input = packetBuffer[PACKET_HEADER_SIZE + i];
+            remoteInputs[frame % INPUT_HISTORY] = input;
+            remoteConfirmed = frame;
+
+            // A tick that already ran with a different guess has to be simulated again
+            if (frame < currentFrame && predictedInputs[frame % INPUT_HISTORY] != input &&
+                (firstIncorrect < 0 || frame < firstIncorrect)) {
+                firstIncorrect = frame;
+            }
+        }
+    }
+}
+
+// Restore the state before the first wrong tick and simulate back up to the present
+void ECE_RollbackSession::rollback()
+{
+    const auto start = std::chrono::steady_clock::now();
+    const int depth = currentFrame - firstIncorrect;
+
+    load(snapshots[firstIncorrect % snapshots.size()]);
+    for (int frame = firstIncorrect; frame < currentFrame; ++frame) {
+        simulate(frame);
+    }
+
+    const long long micros = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    metrics.rollbacks++;
+    metrics.resimulatedTicks += depth;
+    metrics.lastDepth = depth;
+    metrics.maxDepth = std::max(metrics.maxDepth, depth);
+    metrics.lastResimMicros = micros;
+    metrics.maxResimMicros = std::max(metrics.maxResimMicros, micros);
+    metrics.totalResimMicros += micros;
+    firstIncorrect = -1;
+}
+
+// Snapshot the state, then step with the local input and the best known remote input
+void ECE_RollbackSession::simulate(int frame)
+{
+    save(snapshots[frame % snapshots.size()]);
+
+    const PlayerInput local = localInputs[frame % INPUT_HISTORY];
+    const PlayerInput remote = remoteInputFor(frame);
+    predictedInputs[frame % INPUT_HISTORY] = remote;
+
+    if (localPlayer == 0) {
+        step(local, remote);
+    }
+    else {
+        step(remote, local);
+    }
+}
+
+// Send the unacknowledged local inputs, repeated until the remote side confirms them
+void ECE_RollbackSession::sendLocalInput()
+{
+    const int first = std::max(remoteAcked + 1, currentFrame - MAX_INPUTS_PER_PACKET);
+    const std::int32_t ack = remoteConfirmed;
+    const std::int32_t firstFrame = first;
+    const std::uint8_t count = static_cast<std::uint8_t>(std::max(0, currentFrame - first));
+
+    packetBuffer.resize(PACKET_HEADER_SIZE + count);
+    std::memcpy(packetBuffer.data(), &sessionId, 2);
+    std::memcpy(packetBuffer.data() + 2, &ack, 4);
+    std::memcpy(packetBuffer.data() + 6, &firstFrame, 4);
+    std::memcpy(packetBuffer.data() + 10, &count, 1);
+    for (int i = 0; i < count; ++i) {
+        packetBuffer[PACKET_HEADER_SIZE + i] = localInputs[(first + i) % INPUT_HISTORY];
+    }
+
+    transport.send(packetBuffer);
+}
+
+// Confirmed remote input if it has arrived, otherwise repeat the last confirmed one
+PlayerInput ECE_RollbackSession::remoteInputFor(int frame) const
+{
+    if (frame <= remoteConfirmed) {
+        return remoteInputs[frame % INPUT_HISTORY];
+    }
+    return remoteConfirmed >= 0 ? remoteInputs[remoteConfirmed % INPUT_HISTORY] : 0;
+}
@@ -0,0 +1,96 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Rollback session for the two-player mode. Every tick the local input is applied
+right away and the remote input is predicted (the last confirmed remote input is
+repeated). When the real remote input arrives and differs from the prediction, the
+session restores the snapshot taken before the mispredicted tick and re-simulates
+up to the present. The game plugs in through three callbacks: save, load and step.
+*/
+#ifndef ECE_ROLLBACK_H
+#define ECE_ROLLBACK_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "ECE_NetTransport.h"
+#include "ECE_PlayerInput.h"
+
+// Constants
+const int MAX_ROLLBACK_FRAMES = 32;    // Deepest rollback before the local side stalls
+const int INPUT_HISTORY = 128;         // Ticks of input kept for both players
+
+// Rollback and resimulation statistics
+struct ECE_RollbackMetrics {
+    long long ticks = 0;               // Ticks simulated for the first time
+    long long rollbacks = 0;           // Number of corrections
+    long long resimulatedTicks = 0;    // Ticks simulated again during corrections
+    int lastDepth = 0;                 // Depth of the most recent rollback in ticks
+    int maxDepth = 0;                  // Deepest rollback so far
+    long long lastResimMicros = 0;     // Time of the most recent rollback (load + resimulate)
+    long long maxResimMicros = 0;      // Slowest rollback so far
+    long long totalResimMicros = 0;    // Time spent in all rollbacks
+    long long stalls = 0;              // Ticks skipped waiting for remote input
+};
+
+class ECE_RollbackSession {
+public:
+    // Callbacks into the game: serialize state, restore state, advance one tick with both players' inputs
+    typedef std::function<void(std::vector<std::uint8_t>&)> SaveFunction;
+    typedef std::function<bool(const std::vector<std::uint8_t>&)> LoadFunction;
+    typedef std::function<void(PlayerInput playerOne, PlayerInput playerTwo)> StepFunction;
+
+    // Constructor: localPlayer is 0 or 1 and decides the input order passed to step
+    ECE_RollbackSession(ECE_NetTransport& transport, int localPlayer, std::uint16_t sessionId,
+        SaveFunction save, LoadFunction load, StepFunction step);
+
+    // Reads remote input, corrects mispredictions, then simulates one tick with the local input.
+    // Returns false if the tick was skipped because the remote side is too far behind.
+    bool advance(PlayerInput localInput);
+
+    // Getter for the next tick to be simulated
+    int getFrame() const { return currentFrame; }
+
+    // Getter for the rollback and resimulation statistics
+    const ECE_RollbackMetrics& getMetrics() const { return metrics; }
+
+private:
+    // Reads all waiting packets and records the remote inputs they confirm
+    void receiveRemoteInput();
+
+    // Restores the earliest mispredicted tick and re-simulates up to the present
+    void rollback();
+
+    // Simulates one tick, taking a snapshot first so it can be rolled back later
+    void simulate(int frame);
+
+    // Sends every local input the remote side hasn't acknowledged yet
+    void sendLocalInput();
+
+    // Remote input to use for a tick: confirmed if known, otherwise the last confirmed one
+    PlayerInput remoteInputFor(int frame) const;
+
+    ECE_NetTransport& transport;
+    int localPlayer;
+    std::uint16_t sessionId;
+    SaveFunction save;
+    LoadFunction load;
+    StepFunction step;
+
+    int currentFrame;                  // Next tick to simulate
+    int remoteConfirmed;               // Last tick whose remote input is known, all earlier ones too
+    int remoteAcked;                   // Last local tick the remote side has confirmed
+    int firstIncorrect;                // Earliest tick simulated with a wrong prediction, -1 if none
+
+    std::vector<PlayerInput> localInputs;      // Local input per tick (ring buffer)
+    std::vector<PlayerInput> remoteInputs;     // Confirmed remote input per tick (ring buffer)
+    std::vector<PlayerInput> predictedInputs;  // Remote input actually used per tick (ring buffer)
+    std::vector<std::vector<std::uint8_t>> snapshots;  // State before each recent tick (ring buffer)
+    Packet packetBuffer;                       // Reused for sending and receiving
+
+    ECE_RollbackMetrics metrics;
+};
+
+#endif // ECE_ROLLBACK_H
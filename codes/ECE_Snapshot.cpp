@@ -0,0 +1,115 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Compact, versioned binary encoding for game state snapshots.
+ECE_SnapshotWriter appends raw little-endian values to a reusable byte buffer and
+ECE_SnapshotReader reads them back with bounds checking. Every snapshot starts with
+a small header (magic, version, payload size) so stale or foreign data is rejected.
+*/
+#include "ECE_Snapshot.h"
+
+// Header layout: magic (4 bytes), version (2 bytes), reserved (2 bytes), payload size (4 bytes)
+static const std::size_t HEADER_SIZE = 12;
+
+// Start a new snapshot, keeping the buffer's capacity so repeated snapshots don't allocate
+ECE_SnapshotWriter::ECE_SnapshotWriter(std::vector<std::uint8_t>& buffer)
+    : buffer(buffer)
+{
+    buffer.clear();
+    write(SNAPSHOT_MAGIC);
+    write(SNAPSHOT_VERSION);
+    write(std::uint16_t(0));
+    write(std::uint32_t(0));  // Payload size, patched in finish()
+}
+
+// Append raw bytes to the end of the buffer
+void ECE_SnapshotWriter::writeBytes(const void* data, std::size_t size)
+{
+    const std::size_t offset = buffer.size();
+    buffer.resize(offset + size);
+    std::memcpy(buffer.data() + offset, data, size);
+}
+
+// Append the string length followed by its characters
+void ECE_SnapshotWriter::writeString(const std::string& text)
+{
+    write(static_cast<std::uint32_t>(text.size()));
+    writeBytes(text.data(), text.size());
+}
+
+// Store the payload size in the header
+void ECE_SnapshotWriter::finish()
+{
+    const std::uint32_t payloadSize = static_cast<std::uint32_t>(buffer.size() - HEADER_SIZE);
+    std::memcpy(buffer.data() + 8, &payloadSize, sizeof(payloadSize));
+}
+
+// Check magic, version and size before any payload is read
+ECE_SnapshotReader::ECE_SnapshotReader(const std::uint8_t* data, std::size_t size)
+    : data(data), size(size), offset(0), valid(true)
+{
+    std::uint32_t magic = 0;
+    std::uint16_t version = 0;
+    std::uint16_t reserved = 0;
+    std::uint32_t payloadSize = 0;
+
+    if (!read(magic) || !read(version) || !read(reserved) || !read(payloadSize) ||
+        magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION ||
+        payloadSize != size - HEADER_SIZE) {
+        valid = false;
+    }
+}
+
+// Copy bytes out of the buffer, failing once the end is reached
+bool ECE_SnapshotReader::readBytes(void* out, std::size_t count)
+{
+    if (!valid || count > size - offset) {
+        valid = false;
+        return false;
+    }
+    std::memcpy(out, data + offset, count);
+    offset += count;
+    return true;
+}
+
+// Read the string length followed by its characters
+bool ECE_SnapshotReader::readString(std::string& text)
+{
+    std::uint32_t length = 0;
+    if (!read(length) || length > size - offset) {
+        valid = false;
+        return false;
+    }
+    text.assign(reinterpret_cast<const char*>(data + offset), length);
+    offset += length;
+    return true;
+}
+
+// A count is only trusted once the records it promises fit in the buffer
+bool ECE_SnapshotReader::readCount(std::uint32_t& count, std::size_t recordSize)
+{
+    if (!read(count) || count > (size - offset) / recordSize) {
+        valid = false;
+        return false;
+    }
+    return true;
+}
+
+// Hash the snapshot eight bytes at a time, then the leftover bytes
+std::uint64_t hashSnapshot(const std::vector<std::uint8_t>& buffer)
+{
+    std::uint64_t value = 14695981039346656037ull;
+    const std::size_t words = buffer.size() / sizeof(std::uint64_t);
+    for (std::size_t i = 0; i < words; ++i) {
+        std::uint64_t word;
+        std::memcpy(&word, buffer.data() + i * sizeof(word), sizeof(word));
+        value = (value ^ word) * 1099511628211ull;
+        value ^= value >> 29;
+    }
+    for (std::size_t i = words * sizeof(std::uint64_t); i < buffer.size(); ++i) {
+        value = (value ^ buffer[i]) * 1099511628211ull;
+    }
+    return value;
+}
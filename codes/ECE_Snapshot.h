@@ -0,0 +1,87 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Compact, versioned binary encoding for game state snapshots.
+ECE_SnapshotWriter appends raw little-endian values to a reusable byte buffer and
+ECE_SnapshotReader reads them back with bounds checking. Every snapshot starts with
+a small header (magic, version, payload size) so stale or foreign data is rejected.
+*/
+#ifndef ECE_SNAPSHOT_H
+#define ECE_SNAPSHOT_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+// Snapshot header values
+const std::uint32_t SNAPSHOT_MAGIC = 0x504E5343;  // "CSNP"
+const std::uint16_t SNAPSHOT_VERSION = 7;         // Bump whenever the layout changes
+
+// Writes values into a byte buffer, reusing its capacity between snapshots
+class ECE_SnapshotWriter {
+public:
+    // Constructor clears the buffer and writes the snapshot header
+    explicit ECE_SnapshotWriter(std::vector<std::uint8_t>& buffer);
+
+    // Appends a trivially copyable value
+    template <typename T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshot values must be trivially copyable");
+        writeBytes(&value, sizeof(T));
+    }
+
+    // Appends raw bytes
+    void writeBytes(const void* data, std::size_t size);
+
+    // Appends a length-prefixed string
+    void writeString(const std::string& text);
+
+    // Patches the payload size into the header, call once after the last write
+    void finish();
+
+private:
+    std::vector<std::uint8_t>& buffer;
+};
+
+// Reads values back out of a snapshot buffer
+class ECE_SnapshotReader {
+public:
+    // Constructor validates the snapshot header
+    ECE_SnapshotReader(const std::uint8_t* data, std::size_t size);
+
+    // Reads a trivially copyable value, returns false if the buffer is exhausted
+    template <typename T>
+    bool read(T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshot values must be trivially copyable");
+        return readBytes(&value, sizeof(T));
+    }
+
+    // Reads raw bytes
+    bool readBytes(void* data, std::size_t size);
+
+    // Reads a length-prefixed string
+    bool readString(std::string& text);
+
+    // Reads an element count, failing if the rest of the buffer can't hold that many records of recordSize bytes
+    bool readCount(std::uint32_t& count, std::size_t recordSize);
+
+    // Checks if the header was valid and no read has run past the end
+    bool isValid() const { return valid; }
+
+private:
+    const std::uint8_t* data;
+    std::size_t size;
+    std::size_t offset;
+    bool valid;
+};
+
+// 64-bit FNV-style hash of a snapshot, for cheap state comparisons
+std::uint64_t hashSnapshot(const std::vector<std::uint8_t>& buffer);
+
+#endif // ECE_SNAPSHOT_H
@@ -0,0 +1,189 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+CPU render backend that draws the game scene into an in-memory RGBA framebuffer,
+so frames can be rendered and saved as PNG without a window or an OpenGL context.
+Sprites are drawn with their full transform (position, origin, scale, rotation),
+color modulation and alpha blending. Blending runs 4 pixels at a time with SSE2
+when available; the scalar path uses the same integer math so both give identical
+pixels. Text needs glyph textures and is not drawn.
+*/
+#include "ECE_SoftwareRenderer.h"
+#include "ECE_Textures.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ECE_USE_SSE2 1
+#endif
+
+// Exact x / 255 for x in [0, 255 * 255], rounded down the same way in the scalar and SSE2 paths
+static inline std::uint32_t div255(std::uint32_t x)
+{
+    return (x + 1 + (x >> 8)) >> 8;
+}
+
+// Blend one source pixel over one opaque destination pixel
+static inline std::uint32_t blendPixel(std::uint32_t src, std::uint32_t dst)
+{
+    const std::uint32_t alpha = src >> 24;
+    std::uint32_t out = 0xFF000000u;
+    for (int shift = 0; shift < 24; shift += 8) {
+        const std::uint32_t s = (src >> shift) & 0xFF;
+        const std::uint32_t d = (dst >> shift) & 0xFF;
+        out |= div255(s * alpha + d * (255 - alpha)) << shift;
+    }
+    return out;
+}
+
+// Blend a row of source pixels over the framebuffer
+static void blendSpan(std::uint32_t* dst, const std::uint32_t* src, std::size_t count)
+{
+    std::size_t i = 0;
+#ifdef ECE_USE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i full = _mm_set1_epi16(255);
+    const __m128i opaque = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+    // Unpack 2 pixels to 16 bits per channel, blend, and divide by 255
+    auto blendHalf = [&](__m128i s, __m128i d) {
+        __m128i alpha = _mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3));
+        alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i x = _mm_add_epi16(_mm_mullo_epi16(s, alpha), _mm_mullo_epi16(d, _mm_sub_epi16(full, alpha)));
+        return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, one), _mm_srli_epi16(x, 8)), 8);
+    };
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i lo = blendHalf(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+        const __m128i hi = blendHalf(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(_mm_packus_epi16(lo, hi), opaque));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] = blendPixel(src[i], dst[i]);
+    }
+}
+
+// Constructor to allocate the framebuffer
+ECE_SoftwareRenderer::ECE_SoftwareRenderer(unsigned int width, unsigned int height)
+    : width(width), height(height), pixels(static_cast<std::size_t>(width) * height), span(width)
+{
+    clear();
+}
+
+// Fill every pixel with the same opaque color
+void ECE_SoftwareRenderer::clear(const sf::Color& color)
+{
+    const std::uint32_t value = 0xFF000000u | (static_cast<std::uint32_t>(color.b) << 16) |
+        (static_cast<std::uint32_t>(color.g) << 8) | color.r;
+    std::fill(pixels.begin(), pixels.end(), value);
+}
+
+// Map each covered framebuffer pixel back into the texture rect and blend the texel
+void ECE_SoftwareRenderer::draw(const sf::Sprite& sprite)
+{
+    const sf::Image* image = findTextureImage(sprite.getTexture());
+    if (!image) {
+        return;
+    }
+
+    const sf::IntRect rect = sprite.getTextureRect();
+    const sf::Vector2u imageSize = image->getSize();
+    const std::uint32_t* texels = reinterpret_cast<const std::uint32_t*>(image->getPixelsPtr());
+    if (rect.width <= 0 || rect.height <= 0 || !texels) {
+        return;
+    }
+
+    // Clip the sprite's screen bounds to the framebuffer
+    const sf::FloatRect bounds = sprite.getGlobalBounds();
+    const int x0 = std::max(0, static_cast<int>(std::floor(bounds.left)));
+    const int y0 = std::max(0, static_cast<int>(std::floor(bounds.top)));
+    const int x1 = std::min(static_cast<int>(width), static_cast<int>(std::ceil(bounds.left + bounds.width)));
+    const int y1 = std::min(static_cast<int>(height), static_cast<int>(std::ceil(bounds.top + bounds.height)));
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+
+    // The inverse transform is affine, so texture coordinates step by a constant per pixel
+    const sf::Transform inverse = sprite.getTransform().getInverse();
+    const sf::Vector2f origin = inverse.transformPoint(sf::Vector2f(x0 + 0.5f, y0 + 0.5f));
+    const sf::Vector2f stepX = inverse.transformPoint(sf::Vector2f(x0 + 1.5f, y0 + 0.5f)) - origin;
+    const sf::Vector2f stepY = inverse.transformPoint(sf::Vector2f(x0 + 0.5f, y0 + 1.5f)) - origin;
+
+    // Color modulation, skipped for plain white sprites
+    const sf::Color tint = sprite.getColor();
+    const bool tinted = tint.r != 255 || tint.g != 255 || tint.b != 255 || tint.a != 255;
+
+    for (int y = y0; y < y1; ++y) {
+        float u = origin.x + stepY.x * (y - y0);
+        float v = origin.y + stepY.y * (y - y0);
+
+        // Gather the texels for this row, transparent where the pixel falls outside the rect
+        const int count = x1 - x0;
+        for (int i = 0; i < count; ++i, u += stepX.x, v += stepX.y) {
+            const int tu = static_cast<int>(std::floor(u));
+            const int tv = static_cast<int>(std::floor(v));
+            std::uint32_t texel = 0;
+            if (tu >= 0 && tv >= 0 && tu < rect.width && tv < rect.height) {
+                const unsigned int sx = static_cast<unsigned int>(rect.left + tu);
+                const unsigned int sy = static_cast<unsigned int>(rect.top + tv);
+                if (sx < imageSize.x && sy < imageSize.y) {
+                    texel = texels[static_cast<std::size_t>(sy) * imageSize.x + sx];
+                }
+            }
+            if (tinted && texel) {
+                texel = div255((texel & 0xFF) * tint.r) |
+                    div255(((texel >> 8) & 0xFF) * tint.g) << 8 |
+                    div255(((texel >> 16) & 0xFF) * tint.b) << 16 |
+                    div255((texel >> 24) * tint.a) << 24;
+            }
+            span[i] = texel;
+        }
+
+        blendSpan(&pixels[static_cast<std::size_t>(y) * width + x0], span.data(), static_cast<std::size_t>(count));
+    }
+}
+
+// Hash the framebuffer bytes
+std::uint64_t ECE_SoftwareRenderer::hash() const
+{
+    std::uint64_t value = 14695981039346656037ull;
+    const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(pixels.data());
+    for (std::size_t i = 0; i < pixels.size() * 4; ++i) {
+        value = (value ^ bytes[i]) * 1099511628211ull;
+    }
+    return value;
+}
+
+// Copy the framebuffer into an sf::Image and save it
+bool ECE_SoftwareRenderer::saveToFile(const std::string& filename) const
+{
+    sf::Image image;
+    image.create(width, height, reinterpret_cast<const sf::Uint8*>(pixels.data()));
+    return image.saveToFile(filename);
+}
+
+// Compare the framebuffer with a reference image pixel by pixel
+long long ECE_SoftwareRenderer::compareToFile(const std::string& filename) const
+{
+    sf::Image reference;
+    if (!reference.loadFromFile(filename) || reference.getSize().x != width || reference.getSize().y != height) {
+        return -1;
+    }
+
+    long long differences = 0;
+    const std::uint8_t* expected = reference.getPixelsPtr();
+    for (std::size_t i = 0; i < pixels.size(); ++i) {
+        if (std::memcmp(&pixels[i], expected + i * 4, 4) != 0) {
+            differences++;
+        }
+    }
+    return differences;
+}
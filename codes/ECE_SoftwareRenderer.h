@@ -0,0 +1,56 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+CPU render backend that draws the game scene into an in-memory RGBA framebuffer,
+so frames can be rendered and saved as PNG without a window or an OpenGL context.
+Sprites are drawn with their full transform (position, origin, scale, rotation),
+color modulation and alpha blending. Blending runs 4 pixels at a time with SSE2
+when available; the scalar path uses the same integer math so both give identical
+pixels. Text needs glyph textures and is not drawn.
+*/
+#ifndef ECE_SOFTWARERENDERER_H
+#define ECE_SOFTWARERENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ECE_SoftwareRenderer {
+public:
+    // Constructor to allocate a framebuffer of the given size
+    ECE_SoftwareRenderer(unsigned int width, unsigned int height);
+
+    // Fills the framebuffer with a solid color
+    void clear(const sf::Color& color = sf::Color::Black);
+
+    // Draws a sprite using the image registered for its texture
+    void draw(const sf::Sprite& sprite);
+
+    // Text is not rasterized (glyphs live in GPU textures), kept so the scene code compiles for both targets
+    void draw(const sf::Text&) {}
+
+    // Getters for the framebuffer
+    unsigned int getWidth() const { return width; }
+    unsigned int getHeight() const { return height; }
+    const std::vector<std::uint32_t>& getPixels() const { return pixels; }
+
+    // 64-bit FNV-1a hash of the framebuffer, used for golden-image comparison
+    std::uint64_t hash() const;
+
+    // Saves the framebuffer as an image file (PNG by extension)
+    bool saveToFile(const std::string& filename) const;
+
+    // Counts pixels that differ from an image file, returns -1 if it can't be loaded or the size differs
+    long long compareToFile(const std::string& filename) const;
+
+private:
+    unsigned int width;
+    unsigned int height;
+    std::vector<std::uint32_t> pixels;   // RGBA bytes in memory order, always opaque
+    std::vector<std::uint32_t> span;     // Texels gathered for one row of a sprite
+};
+
+#endif // ECE_SOFTWARERENDERER_H
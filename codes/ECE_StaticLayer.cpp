@@ -0,0 +1,111 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Cached layer for the mushrooms. A dirty region is cleared to transparent and the
+mushrooms overlapping it are drawn again through a view whose viewport covers only
+that region, which clips them so neighbouring pixels are left untouched.
+*/
+#include "ECE_StaticLayer.h"
+#include <cmath>
+
+// Constructor starts without a render texture
+ECE_StaticLayer::ECE_StaticLayer()
+    : created(false), fullRedraw(true), redrawnRegions(0), redrawnSprites(0)
+{
+}
+
+// Create the offscreen texture
+bool ECE_StaticLayer::create(unsigned int width, unsigned int height)
+{
+    created = texture.create(width, height);
+    dirtyRegions.clear();
+    fullRedraw = true;
+    return created;
+}
+
+// Round the region out to whole pixels and remember it
+void ECE_StaticLayer::markDirty(const sf::FloatRect& region)
+{
+    if (fullRedraw) {
+        return;
+    }
+    if (dirtyRegions.size() >= MAX_DIRTY_REGIONS) {
+        fullRedraw = true;
+        dirtyRegions.clear();
+        return;
+    }
+
+    const float left = std::floor(region.left);
+    const float top = std::floor(region.top);
+    dirtyRegions.push_back(sf::FloatRect(left, top,
+        std::ceil(region.left + region.width) - left, std::ceil(region.top + region.height) - top));
+}
+
+// Redraw what changed and present the texture
+void ECE_StaticLayer::update(const std::list<ECE_Mushroom>& mushrooms)
+{
+    redrawnRegions = 0;
+    redrawnSprites = 0;
+    if (!created || (!fullRedraw && dirtyRegions.empty())) {
+        return;
+    }
+
+    if (fullRedraw) {
+        texture.setView(texture.getDefaultView());
+        texture.clear(sf::Color::Transparent);
+        for (const auto& mushroom : mushrooms) {
+            texture.draw(mushroom);
+        }
+        redrawnRegions = 1;
+        redrawnSprites = mushrooms.size();
+    }
+    else {
+        for (const auto& region : dirtyRegions) {
+            redrawRegion(region, mushrooms);
+        }
+        redrawnRegions = dirtyRegions.size();
+        texture.setView(texture.getDefaultView());
+    }
+
+    texture.display();
+    dirtyRegions.clear();
+    fullRedraw = false;
+}
+
+// Clip to the region with a view, clear it, and draw the mushrooms that reach into it
+void ECE_StaticLayer::redrawRegion(const sf::FloatRect& region, const std::list<ECE_Mushroom>& mushrooms)
+{
+    const sf::Vector2u size = texture.getSize();
+    sf::FloatRect clipped;
+    if (!region.intersects(sf::FloatRect(0, 0, static_cast<float>(size.x), static_cast<float>(size.y)), clipped)) {
+        return;
+    }
+
+    sf::View view(clipped);
+    view.setViewport(sf::FloatRect(clipped.left / size.x, clipped.top / size.y, clipped.width / size.x, clipped.height / size.y));
+    texture.setView(view);
+
+    // Replace the pixels instead of blending, so the region becomes fully transparent
+    sf::RectangleShape clearShape(sf::Vector2f(clipped.width, clipped.height));
+    clearShape.setPosition(clipped.left, clipped.top);
+    clearShape.setFillColor(sf::Color::Transparent);
+    texture.draw(clearShape, sf::RenderStates(sf::BlendNone));
+
+    for (const auto& mushroom : mushrooms) {
+        if (mushroom.getGlobalBounds().intersects(clipped)) {
+            texture.draw(mushroom);
+            redrawnSprites++;
+        }
+    }
+}
+
+// One textured quad for all the mushrooms. Alpha blending onto the transparent layer already multiplied
+// the colors by their alpha, so the composite adds them as they are instead of blending them again.
+void ECE_StaticLayer::draw(sf::RenderTarget& target) const
+{
+    if (created) {
+        target.draw(sf::Sprite(texture.getTexture()), sf::RenderStates(sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha)));
+    }
+}
@@ -0,0 +1,60 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Cached layer for the mushrooms, which only change when one spawns, is damaged or
+is destroyed. The layer keeps them in an offscreen render texture and re-renders
+only the regions marked dirty since the last frame. Each frame then composites
+the layer with one draw call instead of drawing every mushroom sprite.
+*/
+#ifndef ECE_STATICLAYER_H
+#define ECE_STATICLAYER_H
+
+#include <list>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "ECE_Mushroom.h"
+
+// Constants
+const std::size_t MAX_DIRTY_REGIONS = 32;  // More dirty regions than this redraw the whole layer
+
+class ECE_StaticLayer {
+public:
+    ECE_StaticLayer();
+
+    // Creates the render texture in playfield coordinates, the whole layer is dirty afterwards
+    bool create(unsigned int width, unsigned int height);
+
+    // Checks if the render texture was created
+    bool isCreated() const { return created; }
+
+    // Marks the whole layer for redrawing (new game, restored snapshot)
+    void invalidate() { fullRedraw = true; }
+
+    // Marks a region for redrawing, usually the bounds of a mushroom that changed
+    void markDirty(const sf::FloatRect& region);
+
+    // Re-renders the dirty regions from the current mushroom list
+    void update(const std::list<ECE_Mushroom>& mushrooms);
+
+    // Composites the layer onto the target with premultiplied alpha
+    void draw(sf::RenderTarget& target) const;
+
+    // Number of regions and sprites re-rendered by the last update
+    std::size_t getRedrawnRegions() const { return redrawnRegions; }
+    std::size_t getRedrawnSprites() const { return redrawnSprites; }
+
+private:
+    // Clears a region and draws the mushrooms overlapping it, clipped to the region
+    void redrawRegion(const sf::FloatRect& region, const std::list<ECE_Mushroom>& mushrooms);
+
+    sf::RenderTexture texture;
+    std::vector<sf::FloatRect> dirtyRegions;
+    bool created;
+    bool fullRedraw;
+    std::size_t redrawnRegions;
+    std::size_t redrawnSprites;
+};
+
+#endif // ECE_STATICLAYER_H
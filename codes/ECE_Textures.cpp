@@ -0,0 +1,125 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Keeps the CPU-side image of every game texture next to the sf::Texture. The image
+gives sprites their correct size when the game runs headless (no OpenGL context,
+so nothing is uploaded to the GPU) and is the pixel source for the software renderer.
+Images and fonts are read from the asset pack compiled into the game, or from an
+asset directory during development.
+*/
+#include "ECE_Textures.h"
+#include "ECE_AssetPack.h"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <utility>
+
+// Asset pack generated by CentipedeAssetPacker at build time
+extern const unsigned char embeddedAssetPack[];
+extern const std::size_t embeddedAssetPackSize;
+
+// Images keyed by the address of the texture they belong to (game textures are globals)
+static std::map<const sf::Texture*, sf::Image> textureImages;
+
+// Font bytes keyed by the font reading them, sf::Font doesn't copy them
+static std::map<const sf::Font*, std::vector<std::uint8_t>> fontData;
+
+// Development override for the embedded pack
+static std::string assetDirectory;
+
+void setAssetDirectory(const std::string& directory)
+{
+    assetDirectory = directory;
+}
+
+// The embedded pack is only validated on first use
+bool loadAsset(const std::string& name, const std::uint8_t*& data, std::size_t& size,
+               std::vector<std::uint8_t>& buffer, std::string& error)
+{
+    if (!assetDirectory.empty()) {
+        std::ifstream file(assetDirectory + "/" + name, std::ios::binary);
+        if (!file) {
+            error = "cannot open " + assetDirectory + "/" + name;
+            return false;
+        }
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        data = buffer.data();
+        size = buffer.size();
+        return true;
+    }
+
+    static ECE_AssetPack pack;
+    static std::string packError;
+    static const bool packOpened = pack.open(embeddedAssetPack, embeddedAssetPackSize, packError);
+    if (!packOpened) {
+        error = packError;
+        return false;
+    }
+    return pack.read(name, data, size, buffer, error);
+}
+
+// Decode the image first, then upload it to the GPU unless running headless
+bool loadGameTexture(sf::Texture& texture, const std::string& name, bool imageOnly)
+{
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+    std::vector<std::uint8_t> buffer;
+    std::string error;
+    if (!loadAsset(name, data, size, buffer, error)) {
+        std::cerr << error << std::endl;
+        return false;
+    }
+
+    sf::Image& image = textureImages[&texture];
+    if (!image.loadFromMemory(data, size)) {
+        textureImages.erase(&texture);
+        return false;
+    }
+    return imageOnly || texture.loadFromImage(image);
+}
+
+// Keep the bytes next to the font, replacing them only after the font has switched over
+bool loadGameFont(sf::Font& font, const std::string& name)
+{
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+    std::vector<std::uint8_t> buffer;
+    std::string error;
+    if (!loadAsset(name, data, size, buffer, error)) {
+        std::cerr << error << std::endl;
+        return false;
+    }
+    if (!font.loadFromMemory(data, size)) {
+        return false;
+    }
+    fontData[&font] = std::move(buffer);  // Moving keeps the bytes at the same address
+    return true;
+}
+
+// Look up the image registered for a texture
+const sf::Image* findTextureImage(const sf::Texture* texture)
+{
+    auto it = textureImages.find(texture);
+    return it != textureImages.end() ? &it->second : nullptr;
+}
+
+// Use the uploaded size, falling back to the image size
+sf::Vector2u getTextureSize(const sf::Texture& texture)
+{
+    if (texture.getSize().x > 0) {
+        return texture.getSize();
+    }
+    const sf::Image* image = findTextureImage(&texture);
+    return image ? image->getSize() : sf::Vector2u(0, 0);
+}
+
+// An unloaded texture has size zero, so set the rect from the image explicitly
+void setSpriteTexture(sf::Sprite& sprite, const sf::Texture& texture)
+{
+    sprite.setTexture(texture);
+    const sf::Vector2u size = getTextureSize(texture);
+    sprite.setTextureRect(sf::IntRect(0, 0, static_cast<int>(size.x), static_cast<int>(size.y)));
+}
@@ -0,0 +1,42 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Keeps the CPU-side image of every game texture next to the sf::Texture. The image
+gives sprites their correct size when the game runs headless (no OpenGL context,
+so nothing is uploaded to the GPU) and is the pixel source for the software renderer.
+Images and fonts are read from the asset pack compiled into the game, or from an
+asset directory during development.
+*/
+#ifndef ECE_TEXTURES_H
+#define ECE_TEXTURES_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Reads assets from files below this directory instead of the embedded pack, empty to use the pack
+void setAssetDirectory(const std::string& directory);
+
+// Gets an asset's bytes: points into the embedded pack when it is stored there as is, otherwise into buffer
+bool loadAsset(const std::string& name, const std::uint8_t*& data, std::size_t& size,
+               std::vector<std::uint8_t>& buffer, std::string& error);
+
+// Loads an image asset, registers it for the texture and uploads it unless imageOnly is set
+bool loadGameTexture(sf::Texture& texture, const std::string& name, bool imageOnly);
+
+// Loads a font asset, keeping its bytes for as long as the font reads glyphs from them
+bool loadGameFont(sf::Font& font, const std::string& name);
+
+// Returns the image registered for a texture, or nullptr if there is none
+const sf::Image* findTextureImage(const sf::Texture* texture);
+
+// Size of a texture, taken from its image when it was never uploaded
+sf::Vector2u getTextureSize(const sf::Texture& texture);
+
+// Sets a sprite's texture and makes sure its texture rect covers the whole image
+void setSpriteTexture(sf::Sprite& sprite, const sf::Texture& texture);
+
+#endif // ECE_TEXTURES_H
@@ -0,0 +1,171 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Hierarchical timer wheel: scheduling, cascading between levels and snapshots.
+*/
+#include "ECE_TimerWheel.h"
+#include <algorithm>
+
+// Constructor starts at tick 0 with no timers
+ECE_TimerWheel::ECE_TimerWheel()
+    : timers(MAX_TIMERS), now(0), firedMask(0), timerCount(0)
+{
+}
+
+// Drop every timer and slot entry, keeping the slot capacity
+void ECE_TimerWheel::reset()
+{
+    for (auto& level : slots) {
+        for (auto& slot : level) {
+            slot.clear();
+        }
+    }
+    for (auto& timer : timers) {
+        timer.active = false;
+        timer.generation = 0;
+    }
+    now = 0;
+    firedMask = 0;
+    timerCount = 0;
+}
+
+// First due tick is the next one after now that matches the phase
+void ECE_TimerWheel::schedulePeriodic(int id, std::uint32_t period, std::uint32_t phase)
+{
+    Timer& timer = timers[id];
+    period = std::max<std::uint32_t>(period, 1);
+    timer.period = period;
+    timer.due = now + 1 + (phase % period + period - (now + 1) % period) % period;
+    timer.generation++;
+    timer.active = true;
+    timerCount = std::max(timerCount, id + 1);
+    insert(id);
+}
+
+// One-shot timers deactivate when they fire
+void ECE_TimerWheel::schedule(int id, std::uint32_t delay)
+{
+    Timer& timer = timers[id];
+    timer.period = 0;
+    timer.due = now + std::max<std::uint32_t>(delay, 1);
+    timer.generation++;
+    timer.active = true;
+    timerCount = std::max(timerCount, id + 1);
+    insert(id);
+}
+
+// The slot entry stays behind and is skipped as stale
+void ECE_TimerWheel::cancel(int id)
+{
+    timers[id].active = false;
+    timers[id].generation++;
+}
+
+// Advance one tick: cascade the higher levels at the start of their blocks, then fire the current slot
+void ECE_TimerWheel::advance()
+{
+    now++;
+    firedMask = 0;
+
+    for (int level = TIMER_WHEEL_LEVELS - 1; level > 0; --level) {
+        const std::uint64_t lowerSpan = std::uint64_t(1) << (TIMER_WHEEL_BITS * level);
+        if (now % lowerSpan == 0) {
+            cascade(level, static_cast<int>((now >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1)));
+        }
+    }
+
+    pending.swap(slots[0][now & (TIMER_WHEEL_SLOTS - 1)]);
+    for (const SlotEntry& entry : pending) {
+        Timer& timer = timers[entry.id];
+        if (!timer.active || timer.generation != entry.generation) {
+            continue;  // Cancelled or rescheduled since it was put here
+        }
+        if (timer.due != now) {
+            insert(entry.id);  // Clamped far-future timer, not due yet
+            continue;
+        }
+
+        firedMask |= std::uint64_t(1) << entry.id;
+        if (timer.period > 0) {
+            timer.due += timer.period;
+            insert(entry.id);
+        }
+        else {
+            timer.active = false;
+        }
+    }
+    pending.clear();
+}
+
+// Level 0 holds the next 64 ticks, each level above 64 times more. Delays past the top level are
+// parked in its farthest slot and re-inserted when they come down.
+void ECE_TimerWheel::insert(int id)
+{
+    const Timer& timer = timers[id];
+    const std::uint64_t delta = timer.due - now;
+
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= (std::uint64_t(1) << (TIMER_WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+    const std::uint64_t topSpan = std::uint64_t(1) << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS);
+    const std::uint64_t slotTick = delta < topSpan ? timer.due : now + topSpan - 1;
+    const int slot = static_cast<int>((slotTick >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1));
+
+    SlotEntry entry = { static_cast<std::uint32_t>(id), timer.generation };
+    slots[level][slot].push_back(entry);
+}
+
+// Re-insert the live entries of a slot, which now land in a lower level
+void ECE_TimerWheel::cascade(int level, int slot)
+{
+    pending.swap(slots[level][slot]);
+    for (const SlotEntry& entry : pending) {
+        const Timer& timer = timers[entry.id];
+        if (timer.active && timer.generation == entry.generation) {
+            insert(entry.id);
+        }
+    }
+    pending.clear();
+}
+
+// The slots follow from the due ticks, so only the timers are written
+void ECE_TimerWheel::saveState(ECE_SnapshotWriter& writer) const
+{
+    writer.write(now);
+    writer.write(static_cast<std::uint32_t>(timerCount));
+    for (int id = 0; id < timerCount; ++id) {
+        writer.write(timers[id].active);
+        writer.write(timers[id].due);
+        writer.write(timers[id].period);
+    }
+}
+
+// Restore the timers and put the active ones back into their slots
+bool ECE_TimerWheel::loadState(ECE_SnapshotReader& reader)
+{
+    std::uint64_t tick = 0;
+    std::uint32_t count = 0;
+    if (!reader.read(tick) || !reader.read(count) || count > MAX_TIMERS) {
+        return false;
+    }
+
+    reset();
+    now = tick;
+    timerCount = static_cast<int>(count);
+    for (int id = 0; id < timerCount; ++id) {
+        Timer& timer = timers[id];
+        if (!reader.read(timer.active) || !reader.read(timer.due) || !reader.read(timer.period)) {
+            return false;
+        }
+        if (timer.active && timer.due > now) {
+            insert(id);
+        }
+        else {
+            timer.active = false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,85 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Hierarchical timer wheel for the game's periodic systems and cooldowns. Each
+timer is either periodic, firing on the ticks where tick % period == phase, or
+one-shot, firing once after a delay. Timers sit in the slot of the tick they are
+due in: the first level has one slot per tick for the next 64 ticks, each higher
+level covers 64 times the span of the one below and is cascaded down as time
+reaches it. Advancing a tick only looks at one slot, whatever the delays are.
+*/
+#ifndef ECE_TIMERWHEEL_H
+#define ECE_TIMERWHEEL_H
+
+#include <cstdint>
+#include <vector>
+#include "ECE_Snapshot.h"
+
+// Constants
+const int TIMER_WHEEL_BITS = 6;                          // 64 slots per level
+const int TIMER_WHEEL_SLOTS = 1 << TIMER_WHEEL_BITS;
+const int TIMER_WHEEL_LEVELS = 3;                        // Delays up to 64^3 ticks go straight to their slot
+const int MAX_TIMERS = 64;                               // Timer ids fit in one fired mask
+
+class ECE_TimerWheel {
+public:
+    ECE_TimerWheel();
+
+    // Cancels every timer and restarts the tick count at zero
+    void reset();
+
+    // Starts a periodic timer firing on every later tick where tick % period == phase
+    void schedulePeriodic(int id, std::uint32_t period, std::uint32_t phase);
+
+    // Starts a one-shot timer firing delay ticks from now (at least one)
+    void schedule(int id, std::uint32_t delay);
+
+    // Stops a timer
+    void cancel(int id);
+
+    // Checks if a timer is waiting to fire
+    bool isScheduled(int id) const { return timers[id].active; }
+
+    // Moves to the next tick and collects the timers due on it
+    void advance();
+
+    // Checks if a timer fired on the current tick
+    bool fired(int id) const { return (firedMask >> id) & 1; }
+
+    // Getter for the current tick
+    std::uint64_t getTick() const { return now; }
+
+    // Writes and restores the tick and every timer, the slots are rebuilt
+    void saveState(ECE_SnapshotWriter& writer) const;
+    bool loadState(ECE_SnapshotReader& reader);
+
+private:
+    struct Timer {
+        std::uint64_t due;          // Tick the timer fires on next
+        std::uint32_t period;       // 0 for one-shot timers
+        std::uint32_t generation;   // Bumped on every reschedule, older slot entries are stale
+        bool active;
+    };
+
+    struct SlotEntry {
+        std::uint32_t id;
+        std::uint32_t generation;
+    };
+
+    // Puts a timer into the slot its due tick falls in
+    void insert(int id);
+
+    // Moves the entries of a higher-level slot down to the levels below
+    void cascade(int level, int slot);
+
+    std::vector<Timer> timers;
+    std::vector<SlotEntry> slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    std::vector<SlotEntry> pending;  // Entries being processed, reused
+    std::uint64_t now;
+    std::uint64_t firedMask;
+    int timerCount;                  // One past the highest id ever scheduled
+};
+
+#endif // ECE_TIMERWHEEL_H
@@ -0,0 +1,155 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Wave progression for multi-wave levels. The scheduler decides what to spawn and
+when: centipede segments of the current wave, the spider after it was shot, and
+mushrooms regrowing between waves. Spawns are handed out a centipede per tick instead
+of in one burst, and the spawn list of the next wave is prepared while the current
+one is still being played, so wave transitions don't cause frame time spikes.
+*/
+#include "ECE_WaveScheduler.h"
+#include <algorithm>
+#include <utility>
+
+// Constructor starts with no waves
+ECE_WaveScheduler::ECE_WaveScheduler()
+    : playfieldWidth(960), playfieldHeight(540),
+      currentWave(0), spawnedSegments(0), spiderTimer(0), regrowPending(0), regrowTimer(0), regrowCount(0),
+      preparedWave(-1)
+{
+}
+
+// Restart the progression at the first wave
+void ECE_WaveScheduler::start(const std::vector<LevelWave>& newWaves, float width, float height)
+{
+    waves = newWaves;
+    playfieldWidth = width;
+    playfieldHeight = height;
+    currentWave = 0;
+    spawnedSegments = 0;
+    spiderTimer = SPIDER_RESPAWN_TICKS;
+    regrowPending = 0;
+    regrowTimer = 0;
+    regrowCount = 0;
+    preparedWave = -1;
+    prepareCurrentAndNext();
+}
+
+// Hand out at most a small budget of spawns each tick
+void ECE_WaveScheduler::tick(bool fieldClear, bool spiderParked, std::vector<SpawnJob>& jobs)
+{
+    if (isFinished()) {
+        return;
+    }
+
+    // Once the wave is fully spawned and cleared, move on to the prepared next wave
+    if (fieldClear && spawnedSegments == static_cast<int>(currentSegments.size())) {
+        currentWave++;
+        spawnedSegments = 0;
+        regrowPending += MUSHROOMS_REGROWN_PER_WAVE;
+        prepareCurrentAndNext();
+        if (isFinished()) {
+            return;
+        }
+    }
+
+    // Spawn the current wave a whole centipede at a time. Its segments are laid out SEGMENT_SPACING
+    // apart, so they must all be on the field before the next centipede step moves the first ones.
+    const int totalSegments = static_cast<int>(currentSegments.size());
+    for (int i = 0; i < CENTIPEDES_SPAWNED_PER_TICK && spawnedSegments < totalSegments; ++i) {
+        do {
+            jobs.push_back(currentSegments[spawnedSegments++]);
+        } while (spawnedSegments < totalSegments && currentSegments[spawnedSegments].segmentIndex != 0);
+    }
+
+    // Bring the spider back some time after it was shot
+    if (spiderParked) {
+        if (--spiderTimer <= 0) {
+            SpawnJob spider = { SpawnJob::SPIDER, playfieldWidth, playfieldHeight, 0, 0 };
+            jobs.push_back(spider);
+            spiderTimer = SPIDER_RESPAWN_TICKS;
+        }
+    }
+
+    // Regrow mushrooms one at a time, at spread-out positions that don't need the game's RNG
+    if (regrowPending > 0 && --regrowTimer <= 0) {
+        const float x = 40 + static_cast<float>((regrowCount * 397) % 881) / 881.0f * (playfieldWidth - 80);
+        const float y = 80 + static_cast<float>((regrowCount * 211) % 577) / 577.0f * (playfieldHeight - 200);
+        SpawnJob mushroom = { SpawnJob::MUSHROOM, x, y, 0, 0 };
+        jobs.push_back(mushroom);
+        regrowCount++;
+        regrowPending--;
+        regrowTimer = MUSHROOM_REGROW_TICKS;
+    }
+}
+
+// Centipedes times their length, over every wave
+int ECE_WaveScheduler::getLargestWaveSegments() const
+{
+    int largest = 0;
+    for (const LevelWave& wave : waves) {
+        largest = std::max(largest, static_cast<int>(wave.centipedes * wave.length));
+    }
+    return largest;
+}
+
+// Save the counters, the spawn lists follow from currentWave
+void ECE_WaveScheduler::saveState(ECE_SnapshotWriter& writer) const
+{
+    writer.write(currentWave);
+    writer.write(spawnedSegments);
+    writer.write(spiderTimer);
+    writer.write(regrowPending);
+    writer.write(regrowTimer);
+    writer.write(regrowCount);
+}
+
+// Restore the counters and rebuild the spawn lists if the wave changed
+bool ECE_WaveScheduler::loadState(ECE_SnapshotReader& reader)
+{
+    if (!reader.read(currentWave) || !reader.read(spawnedSegments) || !reader.read(spiderTimer) ||
+        !reader.read(regrowPending) || !reader.read(regrowTimer) || !reader.read(regrowCount)) {
+        return false;
+    }
+    if (currentWave < 0 || currentWave > static_cast<int>(waves.size())) {
+        return false;
+    }
+    prepareCurrentAndNext();
+    return spawnedSegments >= 0 && spawnedSegments <= static_cast<int>(currentSegments.size());
+}
+
+// Lay out every centipede of a wave, head first, in the order they should spawn
+void ECE_WaveScheduler::prepareWave(int wave, std::vector<SpawnJob>& segments) const
+{
+    segments.clear();
+    if (wave < 0 || wave >= static_cast<int>(waves.size())) {
+        return;
+    }
+
+    const LevelWave& data = waves[wave];
+    for (std::uint32_t c = 0; c < data.centipedes; ++c) {
+        for (std::uint32_t i = 0; i < data.length; ++i) {
+            SpawnJob segment = { SpawnJob::SEGMENT, data.startX - i * SEGMENT_SPACING,
+                data.startY + c * data.rowSpacing, data.speed, static_cast<int>(i) };
+            segments.push_back(segment);
+        }
+    }
+}
+
+// Reuse the list prepared ahead when advancing by one wave, otherwise build both
+void ECE_WaveScheduler::prepareCurrentAndNext()
+{
+    if (preparedWave == currentWave) {
+        return;
+    }
+    if (preparedWave >= 0 && preparedWave + 1 == currentWave) {
+        std::swap(currentSegments, nextSegments);
+    }
+    else {
+        prepareWave(currentWave, currentSegments);
+    }
+    prepareWave(currentWave + 1, nextSegments);
+    preparedWave = currentWave;
+}
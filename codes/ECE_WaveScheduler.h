@@ -0,0 +1,85 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Wave progression for multi-wave levels. The scheduler decides what to spawn and
+when: centipede segments of the current wave, the spider after it was shot, and
+mushrooms regrowing between waves. Spawns are handed out a centipede per tick instead
+of in one burst, and the spawn list of the next wave is prepared while the current
+one is still being played, so wave transitions don't cause frame time spikes.
+*/
+#ifndef ECE_WAVESCHEDULER_H
+#define ECE_WAVESCHEDULER_H
+
+#include <vector>
+#include "ECE_Level.h"
+#include "ECE_Snapshot.h"
+
+// Constants
+const int CENTIPEDES_SPAWNED_PER_TICK = 1; // Whole centipedes spawned per spawn tick
+const int SPIDER_RESPAWN_TICKS = 6000;     // Ticks before a shot spider comes back
+const int MUSHROOMS_REGROWN_PER_WAVE = 6;  // Mushrooms that regrow after a wave is cleared
+const int MUSHROOM_REGROW_TICKS = 120;     // Ticks between two regrown mushrooms
+const float SEGMENT_SPACING = 18.4f;       // Horizontal distance between centipede segments at spawn
+
+// One thing to spawn this tick
+struct SpawnJob {
+    enum Type { SEGMENT, SPIDER, MUSHROOM };
+    Type type;
+    float x;
+    float y;
+    float speed;          // Segment speed
+    int segmentIndex;     // 0 for a head, body segments count up from it
+};
+
+class ECE_WaveScheduler {
+public:
+    ECE_WaveScheduler();
+
+    // Sets the waves to play and the playfield used for regrowth positions, then restarts at wave 0
+    void start(const std::vector<LevelWave>& newWaves, float playfieldWidth, float playfieldHeight);
+
+    // Appends this tick's spawns to jobs. fieldClear = no centipede segments left, spiderParked = spider was shot.
+    void tick(bool fieldClear, bool spiderParked, std::vector<SpawnJob>& jobs);
+
+    // Checks if every wave has been spawned and cleared
+    bool isFinished() const { return currentWave >= static_cast<int>(waves.size()); }
+
+    // Getter for the wave being played (0-based)
+    int getWave() const { return currentWave; }
+
+    // Number of segments in the next wave, so entities can be allocated ahead of time
+    int getNextWaveSegments() const { return static_cast<int>(nextSegments.size()); }
+
+    // Number of segments in the largest wave
+    int getLargestWaveSegments() const;
+
+    // Writes and restores the progression counters (the prepared spawn lists are rebuilt)
+    void saveState(ECE_SnapshotWriter& writer) const;
+    bool loadState(ECE_SnapshotReader& reader);
+
+private:
+    // Builds the segment spawn list of a wave, empty if the wave doesn't exist
+    void prepareWave(int wave, std::vector<SpawnJob>& segments) const;
+
+    // Makes the prepared lists match currentWave
+    void prepareCurrentAndNext();
+
+    std::vector<LevelWave> waves;
+    float playfieldWidth;
+    float playfieldHeight;
+
+    int currentWave;                     // Wave being played
+    int spawnedSegments;                 // Segments of the current wave already spawned
+    int spiderTimer;                     // Ticks until a parked spider respawns
+    int regrowPending;                   // Mushrooms still to regrow
+    int regrowTimer;                     // Ticks until the next mushroom regrows
+    int regrowCount;                     // Mushrooms regrown so far, picks the next position
+
+    int preparedWave;                    // Wave the segment lists below were built for
+    std::vector<SpawnJob> currentSegments;  // Spawn list of the current wave
+    std::vector<SpawnJob> nextSegments;     // Spawn list of the next wave, prepared ahead
+};
+
+#endif // ECE_WAVESCHEDULER_H
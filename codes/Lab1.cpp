@@ -13,33 +13,82 @@ The game is designed for a single level and ends when either all segments of the
 #include <SFML/Graphics.hpp>
 #include "ECE_Centipede.h"
 #include "ECE_LaserBlast.h"
+#include "ECE_Mushroom.h"
+#include "ECE_MushroomGrid.h"
+#include "ECE_Snapshot.h"
+#include "ECE_PlayerInput.h"
+#include "ECE_NetTransport.h"
+#include "ECE_Rollback.h"
+#include "ECE_Textures.h"
+#include "ECE_SoftwareRenderer.h"
+#include "ECE_StaticLayer.h"
+#include "ECE_Metrics.h"
+#include "ECE_FrameLatency.h"
+#include "ECE_Level.h"
+#include "ECE_WaveScheduler.h"
+#include "ECE_TimerWheel.h"
+#include "ECE_RenderCuller.h"
+#include "ECE_RenderSnapshot.h"
+#include "ECE_Random.h"
 #include <list> 
 #include <random>
+#include <sstream>
+#include <fstream>
+#include <memory>
+#include <cstdlib>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <map>
+#include <cmath>
 
 using namespace sf;
 
 // Constants
 const int NUM_MUSHROOMS = 30;      // Number of mushrooms in the game
 const int FIRE_RATE = 240;         // Fire rate: frames between laser shots
+const int CENTIPEDE_STEP_TICKS = 30;       // Ticks between two centipede steps
+const int COLLISION_TICKS = 30;            // Ticks between two collision passes
+const int SPIDER_MUSHROOM_TICKS = 30;      // Ticks between two spider-mushroom checks
+const int WAVE_SPAWN_TICKS = 1;            // Ticks between two wave scheduler runs
+const int SIM_TICK_RATE = 240;     // Fixed simulation rate (ticks per second) in two-player and threaded mode
+const int SIM_MAX_CATCHUP_TICKS = 60;      // The simulation thread stops catching up when it falls further behind
+const int DIFF_EPISODE_TICKS = 20000;      // Differential runs restart with a new seed after this many ticks
+const int DIFF_MINIMIZE_ATTEMPTS = 256;    // Replays the repro minimizer may spend
+const int SOAK_GAME_TICKS = 100000;        // Soak games still running after this many ticks are restarted
+const std::uint64_t SOAK_RSS_GROWTH_BYTES = 8 << 20;  // Resident memory a soak run may gain after its first game
+const std::int64_t SOAK_LIVE_ALLOCATION_GROWTH = 64;  // Heap blocks a restart may hold over the second one (storage made on first use)
+const double SOAK_TICK_GROWTH = 2.0;       // Late tick p99 may be at most this many times the early one...
+const long long SOAK_TICK_SLACK_NANOS = 20000;  // ...plus this much, so timer noise doesn't fail a run
+const LevelWave BUILTIN_WAVES[] = {       // Built-in level: one centipede of 12 segments, then longer waves
+	{ 1, 12, 5.0f, 218.4f, 50.0f, 0.0f },
+	{ 2, 8, 5.0f, 160.0f, 50.0f, 40.0f },
+	{ 3, 6, 6.0f, 130.0f, 50.0f, 40.0f },
+};
 
 // Global variables
-std::list<sf::Sprite> mushrooms;                 // List of mushrooms
+std::list<ECE_Mushroom> mushrooms;               // List of mushrooms
 std::list<ECE_LaserBlast> laserBlasts;           // List of laser blasts
 sf::Sprite spaceship;                            // Player's spaceship sprite
+sf::Sprite spaceship2;                           // Second player's spaceship sprite (two-player mode)
 sf::Sprite spider;                               // Spider enemy sprite
 std::list<ECE_Centipede*> centipedeSegments;     // List of centipede segments (head and body)
 sf::Sprite background;                           // Background sprite
 sf::Sprite StartupScreen;                        // Startup screen sprite
 std::vector<sf::Sprite> spaceshipIcons;          // Spaceship icons for remaining lives display
-int spaceshipLives = 3;                          // Initial number of spaceship lives
+const int SPACESHIP_LIVES = 3;                   // Lives at the start of a game
+int spaceshipLives = SPACESHIP_LIVES;            // Remaining spaceship lives
 sf::Vector2f initialSpaceshipPosition;           // Initial position of the spaceship
+sf::Vector2f initialSpaceship2Position;          // Initial position of the second spaceship
 sf::Font font;                                   // Font for text display
 sf::Text scoreText;                              // Text to display score
 sf::Text gameOverText;                           // Text for Game Over screen
 sf::Text finalScoreText;                         // Text to display final score
 sf::Text gameRestartText;                        // Text for restarting the game
 std::random_device rd;                           // Random device for random number generation
-std::mt19937 gen(rd());                          // Mersenne Twister random number generator
+ECE_Random gen(rd());                            // Mersenne Twister that counts its draws for snapshots
 
 // Textures
 sf::Texture textureStarship;               // Texture for the spaceship
@@ -51,26 +100,427 @@ sf::Texture textureCentipedeHead;          // Texture for the centipede head
 sf::Texture textureLaser;                  // Texture for laser blasts
 sf::Texture textureStartupScreen;          // Texture for the startup screen
 
+// Textures render snapshots refer to by index
+enum TextureId {
+	TEXTURE_STARSHIP,
+	TEXTURE_SPIDER,
+	TEXTURE_MUSHROOM_0,
+	TEXTURE_MUSHROOM_1,
+	TEXTURE_CENTIPEDE_HEAD,
+	TEXTURE_CENTIPEDE_BODY,
+	TEXTURE_LASER,
+	TEXTURE_COUNT
+};
+const sf::Texture* const snapshotTextures[TEXTURE_COUNT] = {
+	&textureStarship, &textureSpider, &textureMashroom0, &textureMashroom1,
+	&textureCentipedeHead, &textureCentipedeBody, &textureLaser
+};
+
 // Game state variables
 bool paused = true;                        // Game paused state
 int score = 0;                             // Player's score
-int frameCounter = 0;                      // Frame counter (for timing events)
-int laserFireCounter = 0;                  // Counter for controlling laser fire intervals
+bool staggerSystems = false;               // Spread the periodic systems over different ticks
+bool twoPlayerMode = false;                // Two ships share the field
+bool headless = false;                     // No window or OpenGL context: images only, no text layout
+bool trailMovement = false;                // Body segments follow their head's recorded path
+bool mushroomGridMode = false;             // Mushrooms snap to tiles and collide through the tile map
+ECE_MushroomGrid mushroomGrid;             // Occupancy and damage bitboards mirroring the mushroom list
+bool referenceCollisions = false;          // Grid-snapped mode still finds collisions by walking the lists (differential runs)
+
+// Cached mushroom layer for the window
+ECE_StaticLayer mushroomLayer;             // Mushrooms rendered offscreen, redrawn only where they changed
+std::vector<sf::FloatRect> changedMushrooms;  // Bounds of mushrooms the laser checks damaged or destroyed
+ECE_RenderCuller renderCuller;             // Skips objects outside the view and counts what each frame submits
+
+// Live metrics export
+const sf::Int64 FRAME_BUDGET_MICROS = 16667;  // Frames longer than this count as dropped (60 Hz)
+ECE_MetricsSegment metricsSegment;         // Shared-memory counters, published when --metrics is given
+std::uint64_t ticksSimulated = 0;          // Ticks run, including rollback resimulation
+std::uint64_t framesPresented = 0;         // Frames published
+std::uint64_t framesDropped = 0;           // Frames over budget
+sf::Int64 updateMicrosMax = 0;             // Longest simulation time of a frame
+sf::Int64 drawMicrosMax = 0;               // Longest draw time of a frame
+
+// Threaded simulation
+bool threadedMode = false;                 // The simulation ticks on its own thread and the main thread draws its snapshots
+ECE_RenderSnapshotBuffer renderSnapshots;  // Snapshots handed from the simulation thread to the main thread
+std::atomic<bool> simulationRunning(false);  // Cleared to stop the simulation thread
+std::atomic<PlayerInput> simulationInput(0); // Newest player one input, sampled by the main thread
+std::atomic<sf::Int64> renderDrawMicros(0);  // Last draw time of the main thread, for the live metrics
+std::uint64_t simulationTicks = 0;         // Ticks run by the simulation thread
+std::uint64_t simulationLateTicks = 0;     // Ticks that started behind schedule
+
+// Level parameters (built-in values unless a level file is loaded)
+ECE_Level level;                           // Level file loaded with --level
+float playfieldWidth = 960;                // Simulation bounds
+float playfieldHeight = 540;
+float spiderSpeedX = 0.02f;                // Spider's horizontal speed
+float spiderSpeedY = 0.03f;                // Spider's vertical speed
+float spiderMinY = 300;                    // Highest point the spider climbs to
+
+// Periodic systems and cooldowns, each a timer on the wheel
+enum GameTimer {
+	TIMER_CENTIPEDE_STEP,                  // Centipede segments move and check mushrooms
+	TIMER_COLLISIONS,                      // Laser, spider and spaceship collision passes
+	TIMER_SPIDER_MUSHROOMS,                // The spider eats a mushroom it walks over
+	TIMER_WAVE_SPAWNS,                     // The wave scheduler hands out spawns
+	TIMER_FIRE_COOLDOWN,                   // Player one can't fire while this runs
+	TIMER_FIRE_COOLDOWN_2,                 // Player two can't fire while this runs
+};
+ECE_TimerWheel gameTimers;                 // Advanced once per simulation tick
+
+// Wave progression
+ECE_WaveScheduler waveScheduler;           // Decides what spawns on each tick
+std::vector<SpawnJob> spawnJobs;           // This tick's spawns (reused every tick)
+std::vector<ECE_Centipede*> segmentPool;   // Segments allocated ahead of time for the next wave
 bool ended = false;                        // Game end state
 bool playerWon = false;                    // Track if the player won the game
+bool spiderMovingLeft = true;              // Spider horizontal movement direction
+bool spiderMovingUp = false;               // Spider vertical movement direction
+
+// Snapshot state
+std::vector<std::uint8_t> quickSaveSnapshot;      // In-memory snapshot used for instant resume
+const char* SNAPSHOT_FILE = "savestate.bin";     // Snapshot file written on quick save
+const std::size_t MUSHROOM_RECORD_SIZE = sizeof(sf::Vector2f) + sizeof(std::uint8_t);  // Position and damage
+const std::size_t LASER_RECORD_SIZE = sizeof(sf::Vector2f) + sizeof(bool);            // Position and active flag
+const std::uint64_t MAX_RNG_DRAWS = 1ull << 26;  // Far more than a session of restarts draws, keeps a restore's discard short
+
+// Everything a restore reads before it changes the game, so a bad snapshot leaves the game untouched
+struct DecodedSnapshot {
+	int score = 0;
+	int spaceshipLives = 0;
+	bool paused = false, ended = false, playerWon = false;
+	sf::Vector2f spaceshipPosition, initialSpaceshipPosition, spaceship2Position, initialSpaceship2Position;
+	std::uint32_t lifeIcons = 0;
+	sf::Vector2f spiderPosition;
+	bool spiderMovingLeft = false, spiderMovingUp = false;
+	ECE_TimerWheel timers;
+	ECE_WaveScheduler waves;
+	std::list<ECE_Centipede*> segments;               // Spare segments, swapped with the live ones on success
+	std::vector<LevelMushroom> mushrooms;
+	std::vector<std::pair<sf::Vector2f, bool>> lasers;  // Position and active flag
+	bool hasRng = false;
+	ECE_Random::result_type rngSeed = 0;
+	std::uint64_t rngDraws = 0;
+};
+DecodedSnapshot restoredState;                    // Reused by every restore so its buffers keep their capacity
+
+// Differential runs (reused every tick)
+std::vector<std::uint8_t> diffStateBefore;       // State both collision paths start the tick from
+std::vector<std::uint8_t> diffStateReference;    // State after the list-walking reference path
+std::vector<std::uint8_t> diffStateOptimized;    // State after the tile map path
+ECE_MushroomGrid diffGridOptimized;              // Tile map after the tile map path, carried to the next tick
 
 // Function declarations
-void initGame(RenderWindow& window);       // Initialize the game
+void initGame(const sf::Vector2u& windowSize);  // Initialize the game
 void updateGame();                         // Update game state (called every frame)
+void updateScoreText();                    // Refresh and center the score text
 void drawGame(sf::RenderWindow& window, bool paused);  // Render the game scene
+template <typename Target>
+void drawScene(Target& target, bool paused, bool includeShips = true);  // Draw the scene to a window or the software renderer
+template <typename Target>
+void drawShips(Target& target);            // Draw the spaceships
+int runHeadlessRender(int ticks, int renderEvery, const std::string& dumpDir, const std::string& goldenDir,
+	const std::string& goldenHashFile);
+int runDifferentialTest(long long ticks, unsigned int seed, const std::string& reproFile);  // Compare both collision paths under random input
+int replayDifferentialRepro(const std::string& reproFile);  // Replay a repro written by runDifferentialTest
+void resetGameEntities();                  // Free the segments and empty the entity lists
+void freeGameEntities();                   // Also free the pooled and spare segments, at shutdown
+void startDiffEpisode(unsigned int seed);  // Start a fresh headless game from a seed
+bool stepDifferentialTick(PlayerInput input);  // Run one tick through both collision paths, false if they disagree
+int findDivergence(unsigned int seed, const std::vector<PlayerInput>& inputs);  // First diverging tick of an input log, -1 if none
+void minimizeDivergence(unsigned int seed, std::vector<PlayerInput>& inputs);  // Shrink a diverging input log
+int runSoakTest(int games, unsigned int seed, const std::string& logFile);  // Autoplay many games and check for resource growth
+void drawMushrooms(sf::RenderWindow& window);        // Composite the cached mushroom layer
+void drawMushrooms(ECE_SoftwareRenderer& renderer);  // Draw every visible mushroom sprite
+sf::FloatRect getVisibleArea(const sf::RenderWindow& window);        // Area the window's view shows
+sf::FloatRect getVisibleArea(const ECE_SoftwareRenderer& renderer);  // Area the framebuffer covers
+template <typename Target, typename Object>
+void drawVisible(Target& target, const Object& object);  // Draw an object unless it is outside the view
+void runSpawnScheduler();                  // Spawn this tick's segments, spider and mushrooms
+void resetSpiderPosition();                // Put the spider at its start position
+bool isSpiderParked();                     // Check if the spider was shot and moved off the field
 void updateSpiderMovement();               // Update spider movement
-void handleSpaceshipHit();
+void handleSpaceshipHit(sf::Sprite& ship, const sf::Vector2f& respawnPosition);
 bool isOverlapping(const sf::Sprite& sprite1, const sf::Sprite& sprite2); // Check sprite collision
-bool checkSpaceshipMushroomCollision();    // Check for collisions between spaceship and mushrooms
+bool checkSpaceshipMushroomCollision(const sf::Sprite& ship);  // Check for collisions between a spaceship and mushrooms
+bool useMushroomGrid();                    // Check if collision queries go through the tile map
+void startGameTimers();                    // Register the periodic systems and the first fire cooldowns
+bool snapMushroom(std::list<ECE_Mushroom>::iterator mushroomIt); // Move a listed mushroom onto its tile and mark it, false if the tile is taken
+bool addMushroom(const ECE_Mushroom& mushroom); // Append a mushroom, snapped in grid-snapped mode, false if its tile is taken
+void snapNewMushrooms(std::size_t firstNew); // Snap mushrooms appended to the list, dropping those on taken tiles
+void applyPlayerInput(sf::Sprite& ship, GameTimer fireCooldown, PlayerInput input);  // Move a spaceship and fire
+void simulateTick(PlayerInput playerOne, PlayerInput playerTwo);  // Advance the game by one tick
+void printRollbackMetrics(const ECE_RollbackSession& session, const ECE_NetTransport& transport);
+void publishMetrics(sf::Int64 updateMicros, sf::Int64 drawMicros, sf::Int64 frameMicros);  // Write the live counters
+std::uint8_t getTextureId(const sf::Texture* texture);  // Index of a texture in the snapshot texture table
+void captureRenderSnapshot(RenderSnapshot& snapshot);  // Copy what the next frame shows
+void drawRenderSnapshot(sf::RenderWindow& window, const RenderSnapshot& snapshot);  // Draw a snapshot of the simulation thread
+void runSimulationThread();                // Fixed-rate ticks and snapshots until stopped or the game ends
+void saveGameSnapshot(std::vector<std::uint8_t>& buffer, bool includeRng = true);  // Serialize the full game state
+bool decodeGameSnapshot(const std::vector<std::uint8_t>& buffer, DecodedSnapshot& state);  // Read a snapshot without applying it
+bool restoreGameSnapshot(const std::vector<std::uint8_t>& buffer); // Restore the full game state
+
+
+int main(int argc, char* argv[])
+{
+	// Two-player options
+	bool versusLoopback = false;               // Second player on the same keyboard, routed through an in-process link
+	bool versusUdp = false;                    // Second player in another instance, over UDP on localhost
+	int localPlayer = 0;                       // Which ship this instance controls over UDP
+	unsigned short localPort = 7000, remotePort = 7001;
+	int latencyMs = 0;                         // Artificial one-way latency
+	float lossRate = 0.0f;                     // Artificial packet loss
+	unsigned int seed = 6122;                  // Shared seed so both peers build the same field
+
+	// Headless software rendering options
+	int headlessTicks = 0;                     // Ticks to simulate without a window, 0 = normal game
+	int renderEvery = 60;                      // Render one frame every this many ticks
+	std::string dumpDir;                       // Directory for PNG frame dumps
+	std::string goldenDir;                     // Directory with golden PNGs to compare against
+	std::string goldenHashFile;                // Frame hash list to compare against (the run's own "hash" lines)
+
+	// Live metrics
+	std::string metricsName;                   // Shared-memory segment name, empty = no export
+
+	// Frame pipeline
+	bool lowLatency = false;                   // Sample input and simulate before drawing instead of after
+	bool jitInput = false;                     // Move the ship from input sampled right before present
+	std::string latencyLog;                    // CSV file for the input-to-present samples
+	std::thread simulationThread;              // Runs the game while a threaded round is being played
+	bool simulationEnded = false;              // The newest snapshot says the game ended
+
+	// Soak runs
+	int soakGames = 0;                         // Games to autoplay headless, 0 = no soak run
+	std::string soakLog;                       // CSV file with one line per soak game
+
+	// Differential runs
+	long long diffTicks = 0;                   // Ticks to compare the collision paths for, 0 = no differential run
+	std::string diffOut = "diff_repro.txt";    // Where a minimized repro is written
+	std::string diffReplay;                    // Repro to replay instead of running the game
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "--versus")
+		{
+			versusLoopback = true;
+		}
+		else if (arg == "--trail-movement")
+		{
+			trailMovement = true;
+		}
+		else if (arg == "--mushroom-grid")
+		{
+			mushroomGridMode = true;
+		}
+		else if (arg == "--stagger-systems")
+		{
+			staggerSystems = true;
+		}
+		else if (arg == "--udp" && i + 3 < argc)
+		{
+			versusUdp = true;
+			localPort = static_cast<unsigned short>(std::atoi(argv[++i]));
+			remotePort = static_cast<unsigned short>(std::atoi(argv[++i]));
+			localPlayer = std::atoi(argv[++i]) == 0 ? 0 : 1;
+		}
+		else if (arg == "--latency" && i + 1 < argc)
+		{
+			latencyMs = std::atoi(argv[++i]);
+		}
+		else if (arg == "--loss" && i + 1 < argc)
+		{
+			lossRate = static_cast<float>(std::atof(argv[++i]));
+		}
+		else if (arg == "--seed" && i + 1 < argc)
+		{
+			seed = static_cast<unsigned int>(std::atoi(argv[++i]));
+		}
+		else if (arg == "--assets" && i + 1 < argc)
+		{
+			setAssetDirectory(argv[++i]);  // Load graphic/ and fonts/ from this directory instead of the embedded pack
+		}
+		else if (arg == "--level" && i + 1 < argc)
+		{
+			std::string error;
+			if (!level.open(argv[++i], error))
+			{
+				std::cerr << "Failed to load level: " << error << std::endl;
+				return 1;
+			}
+		}
+		else if (arg == "--convert-level" && i + 2 < argc)
+		{
+			// Convert a text level to the binary format and exit
+			std::string error;
+			if (!convertTextLevel(argv[i + 1], argv[i + 2], error))
+			{
+				std::cerr << "Failed to convert level: " << error << std::endl;
+				return 1;
+			}
+			std::cout << "Wrote " << argv[i + 2] << std::endl;
+			return 0;
+		}
+		else if (arg == "--headless" && i + 1 < argc)
+		{
+			headlessTicks = std::atoi(argv[++i]);
+		}
+		else if (arg == "--render-every" && i + 1 < argc)
+		{
+			renderEvery = std::max(1, std::atoi(argv[++i]));
+		}
+		else if (arg == "--dump" && i + 1 < argc)
+		{
+			dumpDir = argv[++i];
+		}
+		else if (arg == "--golden" && i + 1 < argc)
+		{
+			goldenDir = argv[++i];
+		}
+		else if (arg == "--golden-hashes" && i + 1 < argc)
+		{
+			goldenHashFile = argv[++i];
+		}
+		else if (arg == "--metrics" && i + 1 < argc)
+		{
+			metricsName = argv[++i];
+		}
+		else if (arg == "--low-latency")
+		{
+			lowLatency = true;
+		}
+		else if (arg == "--jit-input")
+		{
+			lowLatency = true;
+			jitInput = true;
+		}
+		else if (arg == "--threaded")
+		{
+			threadedMode = true;
+		}
+		else if (arg == "--latency-log" && i + 1 < argc)
+		{
+			latencyLog = argv[++i];
+		}
+		else if (arg == "--soak" && i + 1 < argc)
+		{
+			soakGames = std::atoi(argv[++i]);
+		}
+		else if (arg == "--soak-log" && i + 1 < argc)
+		{
+			soakLog = argv[++i];
+		}
+		else if (arg == "--diff" && i + 1 < argc)
+		{
+			// Compares the mushroom collision paths only, see runDifferentialTest
+			diffTicks = std::atoll(argv[++i]);
+		}
+		else if (arg == "--diff-out" && i + 1 < argc)
+		{
+			diffOut = argv[++i];
+		}
+		else if (arg == "--diff-replay" && i + 1 < argc)
+		{
+			diffReplay = argv[++i];
+		}
+	}
+
+	// Publish live counters for an external monitor
+	if (!metricsName.empty())
+	{
+		std::string error;
+		if (!metricsSegment.create(metricsName, error))
+		{
+			std::cerr << "Failed to open metrics: " << error << std::endl;
+		}
+	}
 
+	// Soak runs play game after game headless, restarting the way the end screen does
+	if (soakGames > 0)
+	{
+		const int result = runSoakTest(soakGames, seed, soakLog);
+		freeGameEntities();
+		return result;
+	}
+
+	// Differential runs are headless and compare the reference and tile map collision paths
+	if (diffTicks > 0)
+	{
+		const int result = runDifferentialTest(diffTicks, seed, diffOut);
+		freeGameEntities();
+		return result;
+	}
+	if (!diffReplay.empty())
+	{
+		const int result = replayDifferentialRepro(diffReplay);
+		freeGameEntities();
+		return result;
+	}
+
+	// Headless mode renders with the software renderer and never opens a window
+	if (headlessTicks > 0)
+	{
+		gen.seed(seed);
+		const int result = runHeadlessRender(headlessTicks, renderEvery, dumpDir, goldenDir, goldenHashFile);
+		freeGameEntities();
+		return result;
+	}
+	twoPlayerMode = versusLoopback || versusUdp;
+	if (threadedMode && twoPlayerMode)
+	{
+		std::cerr << "The threaded mode is single player only, ignoring --threaded" << std::endl;
+		threadedMode = false;
+	}
+
+	// Set up the link and the rollback session for two-player mode
+	std::unique_ptr<ECE_NetTransport> transport;          // This instance's end of the link
+	std::unique_ptr<ECE_LoopbackTransport> peerTransport;  // The loopback peer's end of the link
+	std::unique_ptr<ECE_RollbackSession> rollbackSession;  // Rollback session driving the simulation
+	std::unique_ptr<ECE_RollbackSession> peerSession;      // Loopback peer: only exchanges input
+	std::uint16_t sessionId = 0;
+
+	if (versusLoopback)
+	{
+		std::unique_ptr<ECE_LoopbackTransport> localTransport;
+		ECE_LoopbackTransport::createPair(localTransport, peerTransport);
+		peerTransport->setConditions(latencyMs, lossRate);
+		transport = std::move(localTransport);
+	}
+	else if (versusUdp)
+	{
+		std::unique_ptr<ECE_UdpTransport> udpTransport(new ECE_UdpTransport());
+		if (!udpTransport->open(localPort, remotePort))
+		{
+			std::cerr << "Failed to open UDP port " << localPort << "!" << std::endl;
+			return 1;
+		}
+		transport = std::move(udpTransport);
+	}
+	if (transport)
+	{
+		transport->setConditions(latencyMs, lossRate);
+		gen.seed(seed);
+	}
+
+	// (Re)start the rollback session, a new id makes both sides ignore packets from the last round
+	auto startVersusSession = [&]()
+	{
+		sessionId++;
+		rollbackSession.reset(new ECE_RollbackSession(*transport, localPlayer, sessionId,
+			[](std::vector<std::uint8_t>& buffer) { saveGameSnapshot(buffer, false); },
+			restoreGameSnapshot,
+			simulateTick));
+		if (peerTransport)
+		{
+			// The peer never simulates, it only sends player two's keys through the link
+			peerSession.reset(new ECE_RollbackSession(*peerTransport, 1, sessionId,
+				[](std::vector<std::uint8_t>& buffer) { buffer.clear(); },
+				[](const std::vector<std::uint8_t>&) { return true; },
+				[](PlayerInput, PlayerInput) {}));
+		}
+	};
 
-int main()
-{
 	// Create a video mode object with lower resolution
 	VideoMode vm(960, 540);
 	RenderWindow window(vm, "Centipede!!!");
@@ -79,26 +529,150 @@ int main()
 	View view(sf::FloatRect(0, 0, 960, 540));
 	window.setView(view);
 
+	// Offscreen layer for the mushrooms covering the playfield they are placed on (the level's, if one is loaded),
+	// drawn sprite by sprite if it can't be created
+	const sf::Vector2f layerSize = level.isOpen()
+		? sf::Vector2f(level.getHeader().playfieldWidth, level.getHeader().playfieldHeight)
+		: sf::Vector2f(playfieldWidth, playfieldHeight);
+	if (!mushroomLayer.create(static_cast<unsigned int>(std::ceil(layerSize.x)), static_cast<unsigned int>(std::ceil(layerSize.y))))
+	{
+		std::cerr << "Failed to create the mushroom layer, drawing mushrooms directly" << std::endl;
+	}
+
 	// Control variables for player input and game state
 	bool acceptInput = false;
+	bool pausedFrameShown = false;             // The start screen doesn't change, so it's drawn once
 
 	// Initialize game elements
-	initGame(window);
+	initGame(window.getSize());
+	if (transport)
+	{
+		startVersusSession();
+	}
+	sf::Clock tickClock;                       // Fixed-rate tick timing in two-player mode
+	sf::Clock metricsClock;                    // Periodic rollback metrics report
+	sf::Clock frameClock;                      // Frame, draw and update timing for the live metrics
+	sf::Clock sectionClock;
+	float tickAccumulator = 0.0f;
+	ECE_LatencyRecorder latencyRecorder;       // Input-to-present timestamps
+
+	// Threaded mode: the simulation thread plays one round, from Return until the game ends
+	auto startSimulation = [&]()
+	{
+		captureRenderSnapshot(renderSnapshots.beginWrite());  // The first frame shows this round, not the last one
+		renderSnapshots.publish();
+		simulationEnded = false;
+		simulationRunning = true;
+		simulationThread = std::thread(runSimulationThread);
+	};
+	auto stopSimulation = [&]()
+	{
+		if (simulationThread.joinable())
+		{
+			simulationRunning = false;
+			simulationThread.join();
+		}
+	};
+
+	// Draw the game (renders all the elements), the start screen only when it needs repainting.
+	// With just-in-time input the ship is moved by the newest keys after the rest of the scene is drawn.
+	auto drawFrame = [&]() -> sf::Int64
+	{
+		if (paused && pausedFrameShown)
+		{
+			sf::sleep(sf::milliseconds(10));
+			return 0;
+		}
+
+		sectionClock.restart();
+		if (simulationThread.joinable())
+		{
+			// Threaded mode draws the newest snapshot and never touches the game state
+			const RenderSnapshot& snapshot = renderSnapshots.acquire();
+			window.clear(sf::Color::Black);
+			drawRenderSnapshot(window, snapshot);
+			window.display();
+			simulationEnded = snapshot.ended;
+		}
+		else if (jitInput && !paused && !rollbackSession)
+		{
+			window.clear(sf::Color::Black);
+			drawScene(window, paused, false);
+			if (acceptInput)
+			{
+				applyPlayerInput(spaceship, TIMER_FIRE_COOLDOWN, sampleKeyboard(PLAYER_ONE_KEYS));
+				latencyRecorder.inputSampled();
+			}
+			drawShips(window);
+			window.display();
+		}
+		else
+		{
+			drawGame(window, paused);
+		}
+		latencyRecorder.framePresented();
+		pausedFrameShown = paused;
+		return sectionClock.getElapsedTime().asMicroseconds();
+	};
 
 	// Main game loop
 	while (window.isOpen())
 	{
-		// Draw the game (renders all the elements)
-		drawGame(window, paused);
+		// Default order: the frame drawn here shows the previous loop's input and simulation
+		sf::Int64 drawMicros = 0;
+		if (!lowLatency)
+		{
+			drawMicros = drawFrame();
+		}
 
 		// Handle player input
 		Event event;
 		while (window.pollEvent(event))
 		{
+			if (event.type == Event::Resized || event.type == Event::GainedFocus)
+			{
+				pausedFrameShown = false;  // The window contents may have been lost
+			}
+
 			if (event.type == Event::KeyReleased && !paused)
 			{
 				acceptInput = true;  // Accept player input when a key is released
 			}
+
+			// F5 quick-saves the game state
+			if (event.type == Event::KeyPressed && event.key.code == Keyboard::F5 && !paused && !twoPlayerMode && !simulationThread.joinable())
+			{
+				sf::Clock snapshotClock;
+				saveGameSnapshot(quickSaveSnapshot);
+				std::cout << "Snapshot saved: " << quickSaveSnapshot.size() << " bytes in "
+					<< snapshotClock.getElapsedTime().asMicroseconds() << " us" << std::endl;
+				std::ofstream file(SNAPSHOT_FILE, std::ios::binary);
+				file.write(reinterpret_cast<const char*>(quickSaveSnapshot.data()), quickSaveSnapshot.size());
+			}
+
+			// F9 restores the last quick save (single player only, a restore would desync two-player mode)
+			if (event.type == Event::KeyPressed && event.key.code == Keyboard::F9 && !twoPlayerMode && !simulationThread.joinable())
+			{
+				// Fall back to the snapshot file so a quick save survives a restart
+				if (quickSaveSnapshot.empty())
+				{
+					std::ifstream file(SNAPSHOT_FILE, std::ios::binary);
+					quickSaveSnapshot.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+				}
+
+				sf::Clock snapshotClock;
+				if (restoreGameSnapshot(quickSaveSnapshot))
+				{
+					std::cout << "Snapshot restored in " << snapshotClock.getElapsedTime().asMicroseconds() << " us" << std::endl;
+					background.setTexture(textureBackground);
+					acceptInput = true;
+					pausedFrameShown = false;
+				}
+				else
+				{
+					std::cerr << "Failed to restore snapshot!" << std::endl;
+				}
+			}
 		}
 
 		// Check for Escape key to close the window
@@ -107,8 +681,8 @@ int main()
 			window.close();
 		}
 
-		// Start the game when Return/Enter is pressed
-		if (Keyboard::isKeyPressed(Keyboard::Return))
+		// Start the game when Return/Enter is pressed (the simulation thread owns the score once it runs)
+		if (Keyboard::isKeyPressed(Keyboard::Return) && !simulationThread.joinable())
 		{
 			paused = false;  // Unpause the game
 			background.setTexture(textureBackground);  // Set gameplay background
@@ -116,62 +690,83 @@ int main()
 			window.clear();  // Clear the window
 			score = 0;  // Reset score
 			acceptInput = true;  // Allow player input
+			if (threadedMode)
+			{
+				startSimulation();
+			}
 		}
 
-		// Player movement and actions when input is accepted
-		if (acceptInput)
+		sectionClock.restart();
+		if (rollbackSession)
 		{
-			// Spaceship movement controls (left, right, up, down)
-			if (Keyboard::isKeyPressed(Keyboard::Left) && spaceship.getPosition().x > 0)
+			// Two-player mode: fixed-rate ticks through the rollback session
+			float elapsed = tickClock.restart().asSeconds();
+			if (!paused)
 			{
-				spaceship.move(-0.3f, 0);
-				if (checkSpaceshipMushroomCollision()) spaceship.move(0.2f, 0);  // Undo movement if collision occurs
-			}
+				tickAccumulator += elapsed;
+				while (tickAccumulator >= 1.0f / SIM_TICK_RATE && !ended)
+				{
+					if (peerSession)
+					{
+						peerSession->advance(sampleKeyboard(PLAYER_TWO_KEYS));
+					}
+					rollbackSession->advance(sampleKeyboard(PLAYER_ONE_KEYS));
+					latencyRecorder.inputSampled();
+					tickAccumulator -= 1.0f / SIM_TICK_RATE;
+				}
 
-			if (Keyboard::isKeyPressed(Keyboard::Right) && spaceship.getPosition().x < 940)
-			{
-				spaceship.move(0.3f, 0);
-				if (checkSpaceshipMushroomCollision()) spaceship.move(-0.2f, 0);  // Undo movement if collision occurs
+				if (metricsClock.getElapsedTime().asSeconds() >= 5.0f)
+				{
+					printRollbackMetrics(*rollbackSession, *transport);
+					metricsClock.restart();
+				}
 			}
+		}
+		else if (simulationThread.joinable())
+		{
+			// Threaded mode: hand the newest keys to the simulation thread, it ticks on its own clock
+			simulationInput.store(acceptInput ? sampleKeyboard(PLAYER_ONE_KEYS) : 0, std::memory_order_relaxed);
 
-			if (Keyboard::isKeyPressed(Keyboard::Up) && spaceship.getPosition().y > 0)
+			// The game state belongs to the main thread again once the thread has finished
+			if (simulationEnded)
 			{
-				spaceship.move(0, -0.3f);
-				if (checkSpaceshipMushroomCollision()) spaceship.move(0, 0.2f);  // Undo movement if collision occurs
+				stopSimulation();
 			}
-
-			if (Keyboard::isKeyPressed(Keyboard::Down) && spaceship.getPosition().y < 510)
+		}
+		else
+		{
+			// Player movement and actions when input is accepted (just-in-time input does this before present)
+			if (acceptInput && !jitInput)
 			{
-				spaceship.move(0, 0.3f);
-				if (checkSpaceshipMushroomCollision()) spaceship.move(0, -0.2f);  // Undo movement if collision occurs
+				applyPlayerInput(spaceship, TIMER_FIRE_COOLDOWN, sampleKeyboard(PLAYER_ONE_KEYS));
+				latencyRecorder.inputSampled();
 			}
 
-			// Spacebar to fire laser
-			if (Keyboard::isKeyPressed(Keyboard::Space) && laserFireCounter >= FIRE_RATE)
+			// Update the game scene if not paused
+			if (!paused)
 			{
-				// Find an off-screen laser and reposition it for firing
-				for (auto& laser : laserBlasts)
-				{
-					if (laser.getPosition().y < 0)  // Laser is off-screen
-					{
-						laser.setPosition(spaceship.getPosition().x, spaceship.getPosition().y);  // Set laser position
-						laserFireCounter = 0;  // Reset fire counter
-						break;  // Only fire one laser at a time
-					}
-				}
+				updateGame();  // Update game logic (centipede, spider, mushrooms, etc.)
 			}
 		}
+		const sf::Int64 updateMicros = sectionClock.getElapsedTime().asMicroseconds();
 
-		// Update the game scene if not paused
-		if (!paused)
+		// Low-latency order: input, simulation, then draw and present right away
+		if (lowLatency && window.isOpen())
+		{
+			drawMicros = drawFrame();
+		}
+		const sf::Int64 frameMicros = frameClock.restart().asMicroseconds();
+		if (simulationThread.joinable())
+		{
+			renderDrawMicros.store(drawMicros, std::memory_order_relaxed);  // The simulation thread publishes the metrics
+		}
+		else
 		{
-			laserFireCounter++;  // Increment fire counter
-			frameCounter++;  // Increment frame counter
-			updateGame();  // Update game logic (centipede, spider, mushrooms, etc.)
+			publishMetrics(updateMicros, drawMicros, frameMicros);
 		}
 
 		// If the game has ended, show the Game Over screen
-		if (ended)
+		if (!simulationThread.joinable() && ended)
 		{
 			// Display game over text
 			gameOverText.setFont(font);
@@ -234,82 +829,147 @@ int main()
 				{
 					paused = true;  // Pause the game to reset
 					ended = false;  // Reset end state
-					initGame(window);  // Reinitialize the game
+					initGame(window.getSize());  // Reinitialize the game
+					if (rollbackSession)
+					{
+						printRollbackMetrics(*rollbackSession, *transport);
+						startVersusSession();
+					}
 					break;  // Exit the end screen loop and restart the game
 				}
 			}
 		}
 	}
 
+	stopSimulation();
+	if (threadedMode)
+	{
+		std::cout << "Simulation thread: " << simulationTicks << " ticks, " << simulationLateTicks << " late" << std::endl;
+	}
+
+	// Report how long input took to reach the screen in this pipeline mode
+	latencyRecorder.printSummary(std::cout, jitInput ? "Just-in-time input" : lowLatency ? "Low-latency pipeline" : "Default pipeline");
+	if (!latencyLog.empty() && !latencyRecorder.writeCsv(latencyLog))
+	{
+		std::cerr << "Failed to write " << latencyLog << std::endl;
+	}
+
+	freeGameEntities();
 	return 0;  // Exit the game
 }
 
 // Function definition
 // Initialize game elements
-void initGame(RenderWindow& window)
-{
-	// Load image resources
-	if (!textureStarship.loadFromFile("graphic/StarShip.png") ||
-		!textureSpider.loadFromFile("graphic/spider.png") ||
-		!textureStartupScreen.loadFromFile("graphic/Startup Screen BackGround.png") ||
-		!textureMashroom0.loadFromFile("graphic/Mushroom0.png") ||
-		!textureMashroom1.loadFromFile("graphic/Mushroom1.png") ||
-		!textureCentipedeBody.loadFromFile("graphic/CentipedeBody.png") ||
-		!textureCentipedeHead.loadFromFile("graphic/CentipedeHead.png") ||
-		!textureBackground.loadFromFile("graphic/background.png") ||
-		!textureLaser.loadFromFile("graphic/laser.png"))
+void initGame(const sf::Vector2u& windowSize)
+{
+	// Load image resources from the embedded asset pack (headless keeps the images only, nothing is uploaded to the GPU)
+	if (!loadGameTexture(textureStarship, "graphic/StarShip.png", headless) ||
+		!loadGameTexture(textureSpider, "graphic/spider.png", headless) ||
+		!loadGameTexture(textureStartupScreen, "graphic/Startup Screen BackGround.png", headless) ||
+		!loadGameTexture(textureMashroom0, "graphic/Mushroom0.png", headless) ||
+		!loadGameTexture(textureMashroom1, "graphic/Mushroom1.png", headless) ||
+		!loadGameTexture(textureCentipedeBody, "graphic/CentipedeBody.png", headless) ||
+		!loadGameTexture(textureCentipedeHead, "graphic/CentipedeHead.png", headless) ||
+		!loadGameTexture(textureBackground, "graphic/background.png", headless) ||
+		!loadGameTexture(textureLaser, "graphic/laser.png", headless))
 	{
 		std::cerr << "Failed to load some textures!" << std::endl;
 		return;  // Exit if textures fail to load
 	}
 
 	// Load font
-	if (!font.loadFromFile("fonts/KOMIKAP_.ttf")) {
+	if (!loadGameFont(font, "fonts/KOMIKAP_.ttf")) {
 		std::cerr << "Error loading font!" << std::endl;
 	}
 
+	// A restart starts from an empty field and full lives
+	resetGameEntities();
+	spaceshipLives = SPACESHIP_LIVES;
+	spiderMovingLeft = true;
+	spiderMovingUp = false;
+
+	// Apply the level's playfield and spider parameters
+	if (level.isOpen()) {
+		const LevelHeader& header = level.getHeader();
+		playfieldWidth = header.playfieldWidth;
+		playfieldHeight = header.playfieldHeight;
+		spiderSpeedX = header.spider.speedX;
+		spiderSpeedY = header.spider.speedY;
+		spiderMinY = header.spider.minY;
+	}
+
 	// Initialize background
-	background.setTexture(textureStartupScreen);
+	setSpriteTexture(background, textureStartupScreen);
 	background.setPosition(0, 0);
-	Vector2u windowSize = background.getTexture()->getSize();
+	Vector2u backgroundSize = getTextureSize(textureStartupScreen);
 	background.setScale(
-		static_cast<float>(window.getSize().x) / windowSize.x,
-		static_cast<float>(window.getSize().y) / windowSize.y
+		static_cast<float>(windowSize.x) / backgroundSize.x,
+		static_cast<float>(windowSize.y) / backgroundSize.y
 	);
 
 	// Initialize spaceship
-	spaceship.setTexture(textureStarship);
-	spaceship.setPosition(window.getSize().x / 2, 500);
+	setSpriteTexture(spaceship, textureStarship);
+	spaceship.setPosition(windowSize.x / 2, 500);
 	initialSpaceshipPosition = spaceship.getPosition();  // Store the initial position for respawning
 
+	// Initialize the second spaceship next to the first one, tinted to tell them apart
+	setSpriteTexture(spaceship2, textureStarship);
+	spaceship2.setColor(sf::Color(120, 200, 255));
+	spaceship2.setPosition(windowSize.x / 2 + 60, 500);
+	initialSpaceship2Position = spaceship2.getPosition();
+
 	// Initialize spaceship icons for remaining lives
 	spaceshipIcons.clear();  // Clear any previous icons
 	for (int i = 0; i < spaceshipLives; ++i) {
-		sf::Sprite lifeIcon(textureStarship);
+		sf::Sprite lifeIcon;
+		setSpriteTexture(lifeIcon, textureStarship);
 		lifeIcon.setPosition(900 - i * 25, 10);  // Position icons in the top-right corner
 		spaceshipIcons.push_back(lifeIcon);  // Add each icon to the vector
 	}
 
 	// Initialize spider at the bottom-right corner
-	spider.setTexture(textureSpider);
+	setSpriteTexture(spider, textureSpider);
 	spider.setScale(0.8f, 0.8f);
-	spider.setPosition(960 - spider.getGlobalBounds().width, 540 - spider.getGlobalBounds().height); // Bottom-right position
+	resetSpiderPosition();
 
-	// Initialize centipede
-	for (int i = 0; i < 12; ++i) {
-		ECE_Centipede* centipede = new ECE_Centipede(textureCentipedeHead, textureCentipedeBody, 218.4f - i * 18.4f, 50.0f, 5.0f, i);
-		centipedeSegments.push_back(centipede);
+	// Initialize the waves, the scheduler spawns the centipedes over the first ticks
+	std::vector<LevelWave> waves(std::begin(BUILTIN_WAVES), std::end(BUILTIN_WAVES));
+	if (level.isOpen() && level.getHeader().waveCount > 0) {
+		waves.assign(level.getWaves(), level.getWaves() + level.getHeader().waveCount);
 	}
+	waveScheduler.start(waves, playfieldWidth, playfieldHeight);
 
-	// Initialize mushrooms without overlapping
+	// The cached mushroom layer is redrawn from scratch for the new field
+	mushroomLayer.invalidate();
+
+	// Restart the periodic systems at tick 0
+	startGameTimers();
+
+	// Tiles the size of a mushroom in grid-snapped mode
 	const float mushroomScale = 0.8f;
-	std::uniform_real_distribution<> xDist(0, 960 - textureMashroom0.getSize().x * mushroomScale);
-	std::uniform_real_distribution<> yDist(70, 480 - textureMashroom0.getSize().y * mushroomScale);
+	if (mushroomGridMode) {
+		mushroomGrid.reset(playfieldWidth, playfieldHeight,
+			getTextureSize(textureMashroom0).x * mushroomScale, getTextureSize(textureMashroom0).y * mushroomScale);
+	}
+
+	// Initialize mushrooms from the level records
+	if (level.isOpen()) {
+		const LevelMushroom* records = level.getMushrooms();
+		for (std::uint32_t i = 0; i < level.getHeader().mushroomCount; ++i) {
+			ECE_Mushroom mushroom(textureMashroom0);
+			mushroom.setPosition(records[i].x, records[i].y);
+			mushroom.setDamage(records[i].damage, textureMashroom0, textureMashroom1);
+			addMushroom(mushroom);
+		}
+	}
 
-	// Generate mushrooms
-	for (int i = 0; i < NUM_MUSHROOMS; ++i) {
-		sf::Sprite mushroom(textureMashroom0);
-		mushroom.setScale(mushroomScale, mushroomScale);
+	// Initialize mushrooms without overlapping
+	std::uniform_real_distribution<> xDist(0, playfieldWidth - getTextureSize(textureMashroom0).x * mushroomScale);
+	std::uniform_real_distribution<> yDist(70, playfieldHeight - 60 - getTextureSize(textureMashroom0).y * mushroomScale);
+
+	// Generate mushrooms (the built-in level places them at random)
+	for (int i = 0; i < NUM_MUSHROOMS && !level.isOpen(); ++i) {
+		ECE_Mushroom mushroom(textureMashroom0);
 
 		bool positionFound = false;
 
@@ -319,6 +979,10 @@ void initGame(RenderWindow& window)
 			float x = xDist(gen);
 			float y = yDist(gen);
 			mushroom.setPosition(x, y);
+			if (mushroomGridMode) {
+				positionFound = addMushroom(mushroom);  // Any free tile will do
+				continue;
+			}
 			positionFound = true;  // Assume valid unless a collision is found
 
 			// Check for overlap with existing mushrooms
@@ -330,8 +994,10 @@ void initGame(RenderWindow& window)
 			}
 		}
 
-		// Add mushroom to the list
-		mushrooms.push_back(mushroom);
+		// Add mushroom to the list (grid-snapped ones were added when their tile was found)
+		if (!mushroomGridMode) {
+			mushrooms.push_back(mushroom);
+		}
 	}
 
 	// Initialize lasers
@@ -343,7 +1009,6 @@ void initGame(RenderWindow& window)
 
 	// Initialize score text
 	scoreText.setFont(font);
-	scoreText.setString("Score: 0");
 	scoreText.setCharacterSize(30);
 	scoreText.setFillColor(sf::Color::White);
 
@@ -352,64 +1017,118 @@ void initGame(RenderWindow& window)
 	playerWon = false;
 
 	// Position score text at the top center of the screen
-	scoreText.setPosition(960 / 2.0f - scoreText.getGlobalBounds().width / 2.0f, 10);
+	updateScoreText();
 }
 
 
 void updateGame()
 {
-	// Update centipede segments every 30 frames
-	if (frameCounter % 30 == 0) {
-		frameCounter = 0;
+	ticksSimulated++;
+	gameTimers.advance();
+
+	// Spawn this tick's share of the current wave, spider and regrown mushrooms
+	if (gameTimers.fired(TIMER_WAVE_SPAWNS)) {
+		runSpawnScheduler();
+	}
 
+	// Step the centipede segments
+	if (gameTimers.fired(TIMER_CENTIPEDE_STEP)) {
 		// Update each segment of the centipede
-		for (auto& body : centipedeSegments) {
-			body->checkBounds(960, 540); // Check for boundary collisions
-			body->handleMushroomCollision(mushrooms); // Handle collisions with mushrooms
-			body->update(); // Update the segment's position
+		if (trailMovement) {
+			ECE_Centipede::updateChains(centipedeSegments, mushrooms, playfieldWidth, playfieldHeight, useMushroomGrid() ? &mushroomGrid : nullptr);
+		}
+		else {
+			for (auto& body : centipedeSegments) {
+				body->checkBounds(playfieldWidth, playfieldHeight); // Check for boundary collisions
+				if (useMushroomGrid()) {
+					body->handleMushroomCollision(mushroomGrid);
+				}
+				else {
+					body->handleMushroomCollision(mushrooms); // Handle collisions with mushrooms
+				}
+				body->update(); // Update the segment's position
+			}
 		}
 	}
 
 	// Update laser movements
 	for (auto& laser : laserBlasts) {
+		if (!laser.isActive()) {
+			continue; // Idle lasers stay parked
+		}
 		laser.update(); // Update laser position
-		// Check if the laser is off-screen and reset its position
+		// Check if the laser is off-screen and park it
 		if (laser.isOffScreen()) {
-			laser.setPosition(-100, -100); // Move off-screen
+			laser.park();
 		}
 	}
 
 	// Update spider movement
 	updateSpiderMovement();
 
-	// Update every 60 frames for collision checks
-	if (frameCounter % 60 == 0) {
+	// Collision passes
+	if (gameTimers.fired(TIMER_COLLISIONS)) {
 		// Check laser collisions with mushrooms
-		score = ECE_LaserBlast::checkLaserMushroomCollision(laserBlasts, mushrooms, textureMashroom0, textureMashroom1, textureLaser,score);
+		if (useMushroomGrid()) {
+			score = ECE_LaserBlast::checkLaserMushroomGridCollision(laserBlasts, mushrooms, mushroomGrid, textureMashroom1, textureLaser, score, &changedMushrooms);
+		}
+		else {
+			score = ECE_LaserBlast::checkLaserMushroomCollision(laserBlasts, mushrooms, textureMashroom1, textureLaser,score, &changedMushrooms);
+			if (mushroomGridMode) {
+				mushroomGrid.rebuild(mushrooms);  // The list walk doesn't maintain the tile map that snapping relies on
+			}
+		}
+		for (const auto& region : changedMushrooms) {
+			mushroomLayer.markDirty(region);
+		}
+		changedMushrooms.clear();
 		// Check laser collisions with spider
 		score = ECE_LaserBlast::checkLaserSpiderCollision(laserBlasts, spider, textureSpider, textureLaser, score);
 		// Check centipede collisions with lasers
+		const std::size_t mushroomCount = mushrooms.size();
 		score = ECE_Centipede::handleLaserCollision(centipedeSegments, mushrooms, laserBlasts, textureMashroom0, textureCentipedeHead, textureCentipedeBody,score);
+		if (mushroomGridMode) {
+			snapNewMushrooms(mushroomCount);  // Mushrooms left by shot segments
+		}
+		for (auto mushroomIt = std::next(mushrooms.begin(), std::min(mushroomCount, mushrooms.size())); mushroomIt != mushrooms.end(); ++mushroomIt) {
+			mushroomLayer.markDirty(mushroomIt->getGlobalBounds());
+		}
 
 		// Check collision between the spider and the spaceship
 		if (isOverlapping(spider, spaceship)) {
-			handleSpaceshipHit(); // Handle spaceship hit
+			handleSpaceshipHit(spaceship, initialSpaceshipPosition); // Handle spaceship hit
 		}
 
 		// Check collision between the centipede and the spaceship
 		if (ECE_Centipede::checkSpaceshipCollision(centipedeSegments, spaceship)) {
-			handleSpaceshipHit(); // Handle spaceship hit
+			handleSpaceshipHit(spaceship, initialSpaceshipPosition); // Handle spaceship hit
+		}
+
+		// The second spaceship shares the lives with the first one
+		if (twoPlayerMode && (isOverlapping(spider, spaceship2) ||
+			ECE_Centipede::checkSpaceshipCollision(centipedeSegments, spaceship2))) {
+			handleSpaceshipHit(spaceship2, initialSpaceship2Position);
 		}
 
-		// Check if the player has won by clearing all centipedes
-		if (centipedeSegments.empty()) {
+		// Check if the player has won by clearing every wave
+		if (waveScheduler.isFinished()) {
 			playerWon = true;
-			std::cout << "Player won! All centipedes cleared." << std::endl;
+			std::cout << "Player won! All waves cleared." << std::endl;
 			ended = true; // End the game
 		}
-		scoreText.setString("Score: " + std::to_string(score));
-		scoreText.setPosition(960 / 2.0f - scoreText.getGlobalBounds().width / 2.0f, 10);
+		updateScoreText();
+	}
+}
+
+// Refresh the score text and keep it centered (text layout needs glyph textures, so not when headless,
+// and in threaded mode the main thread lays it out from the snapshot)
+void updateScoreText()
+{
+	if (headless || threadedMode) {
+		return;
 	}
+	scoreText.setString("Score: " + std::to_string(score) + "   Wave: " + std::to_string(waveScheduler.getWave() + 1));
+	scoreText.setPosition(960 / 2.0f - scoreText.getGlobalBounds().width / 2.0f, 10);
 }
 
 // Draw the game scene
@@ -418,74 +1137,732 @@ void drawGame(sf::RenderWindow& window, bool paused)
 	// Clear the screen to black
 	window.clear(sf::Color::Black);
 
+	drawScene(window, paused);
+
+	// Display the updated window
+	window.display();
+}
+
+// Draw a snapshot in the same order as drawScene, through one reused sprite
+void drawRenderSnapshot(sf::RenderWindow& window, const RenderSnapshot& snapshot)
+{
+	renderCuller.begin(getVisibleArea(window));
+
+	sf::Sprite sprite;
+	auto drawSprites = [&](std::size_t first, std::size_t last)
+	{
+		for (std::size_t i = first; i < last; ++i) {
+			const RenderSprite& data = snapshot.sprites[i];
+			if (data.texture >= TEXTURE_COUNT) {
+				continue;
+			}
+			applyRenderSprite(sprite, data, *snapshotTextures[data.texture]);
+			drawVisible(window, sprite);
+		}
+	};
+
+	// Ships and the spider, then the score text, then the rest
+	const std::size_t hudIndex = std::min(snapshot.hudIndex, snapshot.sprites.size());
+	drawSprites(0, hudIndex);
+	scoreText.setString("Score: " + std::to_string(snapshot.score) + "   Wave: " + std::to_string(snapshot.wave + 1));
+	scoreText.setPosition(960 / 2.0f - scoreText.getGlobalBounds().width / 2.0f, 10);
+	drawVisible(window, scoreText);
+	drawSprites(hudIndex, snapshot.sprites.size());
+}
+
+// Bring the cached layer up to date and draw it in one call
+void drawMushrooms(sf::RenderWindow& window)
+{
+	if (!mushroomLayer.isCreated()) {
+		for (const auto& mushroom : mushrooms) {
+			drawVisible(window, mushroom);
+		}
+		return;
+	}
+	mushroomLayer.update(mushrooms);
+	mushroomLayer.draw(window);
+	renderCuller.submit();
+}
+
+// The software renderer has no offscreen targets, it draws the sprites
+void drawMushrooms(ECE_SoftwareRenderer& renderer)
+{
+	for (const auto& mushroom : mushrooms) {
+		drawVisible(renderer, mushroom);
+	}
+}
+
+// The view can be moved or zoomed, culling follows it
+sf::FloatRect getVisibleArea(const sf::RenderWindow& window)
+{
+	return ECE_RenderCuller::getViewArea(window.getView());
+}
+
+// The software renderer draws in playfield pixels, without a view
+sf::FloatRect getVisibleArea(const ECE_SoftwareRenderer& renderer)
+{
+	return sf::FloatRect(0, 0, static_cast<float>(renderer.getWidth()), static_cast<float>(renderer.getHeight()));
+}
+
+// Objects whose bounds miss the visible area never reach the renderer
+template <typename Target, typename Object>
+void drawVisible(Target& target, const Object& object)
+{
+	if (renderCuller.isVisible(object.getGlobalBounds())) {
+		target.draw(object);
+	}
+}
+
+// Draw the scene to any target with draw(sprite) and draw(text), the window or the software renderer
+template <typename Target>
+void drawScene(Target& target, bool paused, bool includeShips)
+{
+	renderCuller.begin(getVisibleArea(target));
+
 	if (!paused) {
 		// Draw the spaceship
-		window.draw(spaceship);
+		if (includeShips) {
+			drawShips(target);
+		}
 
-		// Draw the spider
-		window.draw(spider);
+		// Draw the spider, unless it was shot and waits off the field
+		if (isSpiderParked()) {
+			renderCuller.skip();
+		}
+		else {
+			drawVisible(target, spider);
+		}
 
 		// Draw the score at the top center of the screen
-		window.draw(scoreText);
+		drawVisible(target, scoreText);
 
 		// Draw spaceship life icons
 		for (const auto& spaceshipIcon : spaceshipIcons) {
-			window.draw(spaceshipIcon);
+			drawVisible(target, spaceshipIcon);
 		}
 
-		// Draw lasers
+		// Draw lasers in flight, idle ones stay parked
 		for (const auto& laser : laserBlasts) {
-			window.draw(laser);
+			if (!laser.isActive()) {
+				renderCuller.skip();
+				continue;
+			}
+			drawVisible(target, laser);
 		}
 
 		// Draw mushrooms
-		for (const auto& mushroom : mushrooms) {
-			window.draw(mushroom);
-		}
+		drawMushrooms(target);
 
 		// Draw the centipede segments
 		for (const auto& body : centipedeSegments) {
-			window.draw(*body); // Draw each segment of the centipede
+			drawVisible(target, *body); // Draw each segment of the centipede
 		}
 	}
 	else {
 		// Draw the background if the game is paused
-		window.draw(background);
+		drawVisible(target, background);
 	}
-
-	// Display the updated window
-	window.display();
 }
 
-
-// Handle spaceship collision and respawn logic
-void handleSpaceshipHit()
+// Draw the player's spaceship and the second one in two-player mode
+template <typename Target>
+void drawShips(Target& target)
 {
-	spaceshipLives--; // Decrease lives
-	std::cout << "Spaceship hit! Lives remaining: " << spaceshipLives << std::endl;
-
-	// Remove the last life icon and respawn the spaceship
-	if (!spaceshipIcons.empty()) {
-		spaceshipIcons.pop_back();
+	drawVisible(target, spaceship);
+	if (twoPlayerMode) {
+		drawVisible(target, spaceship2);
 	}
-	spaceship.setPosition(initialSpaceshipPosition); // Respawn the spaceship
+}
+
+// Simulate with scripted input and render every few ticks into a CPU framebuffer.
+// Frames are written as PNGs and/or compared against golden PNGs or golden frame hashes,
+// render throughput is reported.
+int runHeadlessRender(int ticks, int renderEvery, const std::string& dumpDir, const std::string& goldenDir,
+	const std::string& goldenHashFile)
+{
+	// Golden hashes are the "frame_... hash ..." lines of an earlier run, so a run's output can be committed as is
+	std::map<std::string, std::uint64_t> goldenHashes;
+	if (!goldenHashFile.empty())
+	{
+		std::ifstream file(goldenHashFile);
+		if (!file)
+		{
+			std::cerr << "Cannot open " << goldenHashFile << std::endl;
+			return 1;
+		}
+		std::string line;
+		while (std::getline(file, line))
+		{
+			std::istringstream fields(line);
+			std::string frameName, keyword;
+			std::uint64_t frameHash = 0;
+			if (line.empty() || line[0] == '#' || !(fields >> frameName >> keyword >> std::hex >> frameHash) || keyword != "hash")
+			{
+				continue;  // Comments and the run's other output
+			}
+			goldenHashes[frameName] = frameHash;
+		}
+	}
+
+	headless = true;
+	initGame(sf::Vector2u(960, 540));
+	paused = false;
+
+	ECE_SoftwareRenderer renderer(960, 540);
+	sf::Clock renderClock;
+	sf::Int64 renderMicros = 0;
+	int framesRendered = 0;
+	int goldenMismatches = 0;
+	std::uint64_t objectsSubmitted = 0;
+	std::uint64_t objectsCulled = 0;
+
+	sf::Clock updateClock;
+	for (int tick = 0; tick < ticks && !ended; ++tick)
+	{
+		updateClock.restart();
+		simulateTick(scriptedInput(tick), 0);
+		const sf::Int64 updateMicros = updateClock.getElapsedTime().asMicroseconds();
+		if (tick % renderEvery != 0)
+		{
+			publishMetrics(updateMicros, 0, updateMicros);
+			continue;
+		}
+
+		renderClock.restart();
+		renderer.clear(sf::Color::Black);
+		drawScene(renderer, false);
+		const sf::Int64 drawMicros = renderClock.getElapsedTime().asMicroseconds();
+		renderMicros += drawMicros;
+		objectsSubmitted += renderCuller.getSubmitted();
+		objectsCulled += renderCuller.getCulled();
+		publishMetrics(updateMicros, drawMicros, updateMicros + drawMicros);
+
+		// Frame files are numbered by tick so dumps and goldens line up
+		std::ostringstream name;
+		name << "frame_" << std::setw(7) << std::setfill('0') << tick << ".png";
+		std::cout << name.str() << " hash " << std::hex << renderer.hash() << std::dec << std::endl;
+
+		if (!dumpDir.empty() && !renderer.saveToFile(dumpDir + "/" + name.str()))
+		{
+			std::cerr << "Failed to write " << dumpDir << "/" << name.str() << std::endl;
+		}
+		if (!goldenDir.empty())
+		{
+			long long differences = renderer.compareToFile(goldenDir + "/" + name.str());
+			if (differences != 0)
+			{
+				std::cerr << "Golden mismatch in " << name.str() << ": "
+					<< (differences < 0 ? std::string("missing or wrong size") : std::to_string(differences) + " pixels") << std::endl;
+				goldenMismatches++;
+			}
+		}
+		if (!goldenHashFile.empty())
+		{
+			const auto golden = goldenHashes.find(name.str());
+			if (golden == goldenHashes.end() || golden->second != renderer.hash())
+			{
+				std::cerr << "Golden mismatch in " << name.str() << ": "
+					<< (golden == goldenHashes.end() ? std::string("no golden hash") : std::string("different hash")) << std::endl;
+				goldenMismatches++;
+			}
+		}
+		framesRendered++;
+	}
+
+	// A run that ends early renders fewer frames than were recorded
+	if (!goldenHashFile.empty() && static_cast<std::size_t>(framesRendered) < goldenHashes.size())
+	{
+		std::cerr << "Golden mismatch: " << goldenHashes.size() - framesRendered << " recorded frames were not rendered" << std::endl;
+		goldenMismatches++;
+	}
+
+	std::cout << "Rendered " << framesRendered << " frames, "
+		<< (framesRendered ? renderMicros / framesRendered : 0) << " us/frame, "
+		<< (renderMicros ? framesRendered * 1000000.0 / renderMicros : 0.0) << " frames/s" << std::endl;
+	std::cout << "Objects per frame: "
+		<< (framesRendered ? static_cast<double>(objectsSubmitted) / framesRendered : 0.0) << " submitted, "
+		<< (framesRendered ? static_cast<double>(objectsCulled) / framesRendered : 0.0) << " culled" << std::endl;
+	if (!goldenDir.empty() || !goldenHashFile.empty())
+	{
+		std::cout << "Golden mismatches: " << goldenMismatches << std::endl;
+	}
+	return goldenMismatches == 0 ? 0 : 1;
+}
+
+// Free the centipede segments and empty the entity lists so a new game starts from nothing
+void resetGameEntities()
+{
+	for (auto* body : centipedeSegments) {
+		delete body;
+	}
+	centipedeSegments.clear();
+	mushrooms.clear();
+	laserBlasts.clear();
+	spawnJobs.clear();
+}
+
+// Free the segments kept between games as well: the pool for the next wave and the restore spares
+void freeGameEntities()
+{
+	resetGameEntities();
+	for (auto* body : segmentPool) {
+		delete body;
+	}
+	segmentPool.clear();
+	for (auto* body : restoredState.segments) {
+		delete body;
+	}
+	restoredState.segments.clear();
+}
+
+// Start a new headless game with the given seed, as if the player had just pressed Return
+void startDiffEpisode(unsigned int seed)
+{
+	ended = false;
+	gen.seed(seed);
+	initGame(sf::Vector2u(960, 540));
+	paused = false;
+}
+
+// Run one tick through the tile map path, then again from the same state through the list-walking
+// reference path, and compare the state hashes. The game continues from the tile map path's result
+// with its own tile map, so mistakes in keeping the map up to date carry over into later ticks.
+// The restore makes new mushroom list nodes, so the carried map is relinked to them, which also
+// checks that its occupied tiles still match the list.
+bool stepDifferentialTick(PlayerInput input)
+{
+	saveGameSnapshot(diffStateBefore, false);
+
+	referenceCollisions = false;
+	simulateTick(input, 0);
+	saveGameSnapshot(diffStateOptimized, false);
+	diffGridOptimized = mushroomGrid;
+
+	restoreGameSnapshot(diffStateBefore);
+	referenceCollisions = true;
+	simulateTick(input, 0);
+	saveGameSnapshot(diffStateReference, false);
+	referenceCollisions = false;
+
+	restoreGameSnapshot(diffStateOptimized);
+	mushroomGrid = diffGridOptimized;
+	return mushroomGrid.relink(mushrooms) && hashSnapshot(diffStateReference) == hashSnapshot(diffStateOptimized);
+}
+
+// Replay an input log from a fresh game, returns the first tick where the paths disagree or -1
+int findDivergence(unsigned int seed, const std::vector<PlayerInput>& inputs)
+{
+	startDiffEpisode(seed);
+	for (std::size_t tick = 0; tick < inputs.size() && !ended; ++tick) {
+		if (!stepDifferentialTick(inputs[tick])) {
+			return static_cast<int>(tick);
+		}
+	}
+	return -1;
+}
+
+// Cut the log after the divergence, then clear ever smaller runs of input as long as it still diverges
+void minimizeDivergence(unsigned int seed, std::vector<PlayerInput>& inputs)
+{
+	int divergence = findDivergence(seed, inputs);
+	if (divergence < 0) {
+		return;
+	}
+	inputs.resize(divergence + 1);
+
+	int attempts = 0;
+	for (std::size_t chunk = std::max<std::size_t>(inputs.size() / 2, 1); chunk >= 1 && attempts < DIFF_MINIMIZE_ATTEMPTS; chunk /= 2) {
+		for (std::size_t start = 0; start < inputs.size() && attempts < DIFF_MINIMIZE_ATTEMPTS; start += chunk) {
+			std::vector<PlayerInput> candidate(inputs);
+			const std::size_t end = std::min(start + chunk, candidate.size());
+			if (std::all_of(candidate.begin() + start, candidate.begin() + end, [](PlayerInput input) { return input == 0; })) {
+				continue;  // Nothing to clear
+			}
+			std::fill(candidate.begin() + start, candidate.begin() + end, 0);
+
+			attempts++;
+			divergence = findDivergence(seed, candidate);
+			if (divergence >= 0) {
+				candidate.resize(divergence + 1);
+				inputs.swap(candidate);
+			}
+		}
+	}
+}
+
+// Run the game headless in grid-snapped mode under random held inputs and random seeds, stepping the
+// reference and the tile map collision paths in lockstep. A divergence is minimized and written as a repro.
+// Only collisions with mushrooms have two paths (lasers, spider, centipede and ships against the tile map
+// or the list). Laser-centipede and laser-spider collisions have a single implementation that both sides
+// run, so the comparison can't catch mistakes in them.
+int runDifferentialTest(long long ticks, unsigned int seed, const std::string& reproFile)
+{
+	headless = true;
+	mushroomGridMode = true;
+	std::mt19937 inputGen(seed);  // Separate from gen so the inputs don't change the field
+
+	// Hits and wins are reported on every episode, keep them out of the summary
+	std::streambuf* coutBuffer = std::cout.rdbuf(nullptr);
+
+	std::vector<PlayerInput> inputs;
+	long long ticksRun = 0;
+	int episodes = 0;
+	int divergence = -1;
+	unsigned int episodeSeed = seed;
+	sf::Clock runClock;
+	while (ticksRun < ticks && divergence < 0) {
+		episodeSeed = seed + episodes;
+		startDiffEpisode(episodeSeed);
+		inputs.clear();
+		episodes++;
+
+		// Hold each random input for a while, like a player would
+		PlayerInput held = 0;
+		int holdTicks = 0;
+		while (!ended && ticksRun < ticks && inputs.size() < static_cast<std::size_t>(DIFF_EPISODE_TICKS)) {
+			if (holdTicks == 0) {
+				held = static_cast<PlayerInput>(inputGen() & (INPUT_LEFT | INPUT_RIGHT | INPUT_UP | INPUT_DOWN | INPUT_FIRE));
+				holdTicks = 1 + static_cast<int>(inputGen() % 120);
+			}
+			holdTicks--;
+			inputs.push_back(held);
+			ticksRun++;
+			if (!stepDifferentialTick(held)) {
+				divergence = static_cast<int>(inputs.size()) - 1;
+				break;
+			}
+		}
+	}
+	const float seconds = std::max(runClock.getElapsedTime().asSeconds(), 0.001f);
+
+	std::cout.rdbuf(coutBuffer);
+	std::cout.clear();
+	std::cout << "Differential run: " << ticksRun << " ticks in " << episodes << " episodes, "
+		<< static_cast<long long>(ticksRun / seconds) << " ticks/s, "
+		<< std::fixed << std::setprecision(2) << ticksRun * 60.0 / seconds / 1000000.0 << std::defaultfloat
+		<< "M ticks/min" << std::endl;
+	std::cout << "Compared: mushroom collisions, tile map against list walk (laser-centipede and laser-spider "
+		<< "collisions have one implementation and are not compared)" << std::endl;
+	if (divergence < 0) {
+		std::cout << "No divergence" << std::endl;
+		return 0;
+	}
+
+	// Shrink the input log and write it out for --diff-replay
+	std::cout << "Divergence at tick " << divergence << " of seed " << episodeSeed << ", minimizing..." << std::endl;
+	coutBuffer = std::cout.rdbuf(nullptr);
+	minimizeDivergence(episodeSeed, inputs);
+	std::cout.rdbuf(coutBuffer);
+	std::cout.clear();
+
+	std::ofstream file(reproFile);
+	file << "# Differential repro, replay with --diff-replay\n";
+	file << "seed " << episodeSeed << "\n";
+	file << "trail " << (trailMovement ? 1 : 0) << "\n";
+	for (std::size_t tick = 0; tick < inputs.size(); ) {
+		std::size_t count = 1;
+		while (tick + count < inputs.size() && inputs[tick + count] == inputs[tick]) {
+			count++;
+		}
+		file << "hold " << count << " " << static_cast<int>(inputs[tick]) << "\n";
+		tick += count;
+	}
+	std::cout << "Wrote a " << inputs.size() << " tick repro to " << reproFile << std::endl;
+	return 1;
+}
+
+// Replay a repro file and report where the collision paths disagree
+int replayDifferentialRepro(const std::string& reproFile)
+{
+	std::ifstream file(reproFile);
+	if (!file) {
+		std::cerr << "Failed to open " << reproFile << std::endl;
+		return 1;
+	}
+
+	// One keyword per line: seed, trail and hold <ticks> <input>
+	unsigned int seed = 0;
+	std::vector<PlayerInput> inputs;
+	std::string line;
+	while (std::getline(file, line)) {
+		std::istringstream fields(line);
+		std::string keyword;
+		fields >> keyword;
+		if (keyword == "seed") {
+			fields >> seed;
+		}
+		else if (keyword == "trail") {
+			int enabled = 0;
+			fields >> enabled;
+			trailMovement = enabled != 0;
+		}
+		else if (keyword == "hold") {
+			int count = 0, input = 0;
+			fields >> count >> input;
+			inputs.insert(inputs.end(), std::max(count, 0), static_cast<PlayerInput>(input));
+		}
+	}
+
+	headless = true;
+	mushroomGridMode = true;
+	const int divergence = findDivergence(seed, inputs);
+	if (divergence < 0) {
+		std::cout << "No divergence in " << inputs.size() << " ticks" << std::endl;
+		return 0;
+	}
+	std::cout << "Divergence at tick " << divergence << ": reference hash " << std::hex << hashSnapshot(diffStateReference)
+		<< ", tile map hash " << hashSnapshot(diffStateOptimized) << std::dec << std::endl;
+	return 1;
+}
+
+// Autoplay games back to back at full speed, restarting each one like the end screen does. After every
+// game the resident memory, the entity containers and the tick time percentiles are recorded. The run
+// fails if a restart leaves more entities behind than the first one, if live heap blocks or memory keep
+// growing after the first game, or if ticks in the last quarter of the games got much slower than in the first quarter.
+int runSoakTest(int games, unsigned int seed, const std::string& logFile)
+{
+	struct SoakGame {
+		long long ticks;
+		bool won;
+		std::uint64_t residentBytes;
+		std::size_t startMushrooms, startLasers, startSegments, startPool;  // Right after the restart
+		std::size_t peakMushrooms, peakLasers, peakSegments;
+		std::uint64_t allocations;
+		std::int64_t startLiveAllocations;  // Heap blocks not freed, right after the restart
+		long long tickP50, tickP99, tickMax;  // Nanoseconds
+	};
+
+	headless = true;
+	std::streambuf* coutBuffer = std::cout.rdbuf(nullptr);  // Hits and wins are reported every game
+
+	std::vector<SoakGame> results;
+	std::vector<long long> tickNanos;
+	tickNanos.reserve(SOAK_GAME_TICKS);
+	long long totalTicks = 0;
+	sf::Clock runClock;
+	for (int game = 0; game < games; ++game) {
+		ended = false;
+		gen.seed(seed + game);
+		initGame(sf::Vector2u(960, 540));
+		paused = false;
+
+		SoakGame result = {};
+		result.startMushrooms = result.peakMushrooms = mushrooms.size();
+		result.startLasers = result.peakLasers = laserBlasts.size();
+		result.startSegments = result.peakSegments = centipedeSegments.size();
+		result.startPool = segmentPool.size();
+		result.startLiveAllocations = getLiveAllocationCount();
+		const std::uint64_t allocationsBefore = getAllocationCount();
+
+		tickNanos.clear();
+		for (long long tick = 0; tick < SOAK_GAME_TICKS && !ended; ++tick) {
+			const auto start = std::chrono::steady_clock::now();
+			simulateTick(scriptedInput(tick), 0);
+			tickNanos.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+			result.peakMushrooms = std::max(result.peakMushrooms, mushrooms.size());
+			result.peakLasers = std::max(result.peakLasers, laserBlasts.size());
+			result.peakSegments = std::max(result.peakSegments, centipedeSegments.size());
+		}
+
+		result.ticks = static_cast<long long>(tickNanos.size());
+		result.won = playerWon;
+		result.residentBytes = getResidentSetBytes();
+		result.allocations = getAllocationCount() - allocationsBefore;
+		std::sort(tickNanos.begin(), tickNanos.end());
+		if (!tickNanos.empty()) {
+			result.tickP50 = tickNanos[(tickNanos.size() - 1) / 2];
+			result.tickP99 = tickNanos[(tickNanos.size() - 1) * 99 / 100];
+			result.tickMax = tickNanos.back();
+		}
+		results.push_back(result);
+		totalTicks += result.ticks;
+	}
+	const float seconds = std::max(runClock.getElapsedTime().asSeconds(), 0.001f);
+
+	std::cout.rdbuf(coutBuffer);
+	std::cout.clear();
+
+	// One line per game for graphing
+	if (!logFile.empty()) {
+		std::ofstream file(logFile);
+		file << "game,ticks,won,rss_kb,start_mushrooms,start_lasers,start_segments,start_pool,"
+			"peak_mushrooms,peak_lasers,peak_segments,allocations,start_live_allocations,tick_p50_ns,tick_p99_ns,tick_max_ns\n";
+		for (std::size_t i = 0; i < results.size(); ++i) {
+			const SoakGame& r = results[i];
+			file << i << ',' << r.ticks << ',' << r.won << ',' << r.residentBytes / 1024 << ','
+				<< r.startMushrooms << ',' << r.startLasers << ',' << r.startSegments << ',' << r.startPool << ','
+				<< r.peakMushrooms << ',' << r.peakLasers << ',' << r.peakSegments << ',' << r.allocations << ','
+				<< r.startLiveAllocations << ','
+				<< r.tickP50 << ',' << r.tickP99 << ',' << r.tickMax << '\n';
+		}
+		if (!file) {
+			std::cerr << "Failed to write " << logFile << std::endl;
+		}
+	}
+
+	std::cout << "Soak run: " << results.size() << " games, " << totalTicks << " ticks in " << seconds << " s ("
+		<< static_cast<long long>(totalTicks / seconds) << " ticks/s)" << std::endl;
+	const SoakGame& first = results.front();
+	const SoakGame& last = results.back();
+	std::cout << "First game: rss " << first.residentBytes / 1024 << " KB, tick p50/p99/max "
+		<< first.tickP50 << "/" << first.tickP99 << "/" << first.tickMax << " ns" << std::endl;
+	std::cout << "Last game:  rss " << last.residentBytes / 1024 << " KB, tick p50/p99/max "
+		<< last.tickP50 << "/" << last.tickP99 << "/" << last.tickMax << " ns" << std::endl;
+
+	// A restart must start from the same entities as the first game. The segment pool depends on the
+	// wave the last game ended in, but never needs more than the largest wave.
+	int failures = 0;
+	const std::size_t poolLimit = static_cast<std::size_t>(waveScheduler.getLargestWaveSegments());
+	for (std::size_t i = 1; i < results.size(); ++i) {
+		const SoakGame& r = results[i];
+		if (r.startMushrooms > first.startMushrooms || r.startLasers > first.startLasers ||
+			r.startSegments > first.startSegments || r.startPool > poolLimit) {
+			std::cout << "FAIL: restart " << i << " starts with " << r.startMushrooms << " mushrooms, " << r.startLasers
+				<< " lasers, " << r.startSegments << " segments, " << r.startPool << " pooled segments" << std::endl;
+			failures++;
+			break;
+		}
+	}
+
+	// Heap blocks still live at a restart, not counting the entities and pooled segments, must stay flat
+	// from the second restart on (the first comes before any tick). A per-game leak fails this well
+	// before it shows in the resident memory.
+	if (results.size() > 2) {
+		const auto retained = [](const SoakGame& r) {
+			return r.startLiveAllocations - static_cast<std::int64_t>(r.startMushrooms + r.startLasers + r.startSegments + r.startPool);
+		};
+		if (retained(last) > retained(results[1]) + SOAK_LIVE_ALLOCATION_GROWTH) {
+			std::cout << "FAIL: live heap allocations at restart grew from " << retained(results[1]) << " to "
+				<< retained(last) << std::endl;
+			failures++;
+		}
+	}
+
+	// Memory settles during the first game, everything after it should reuse what was allocated
+	if (last.residentBytes > first.residentBytes + SOAK_RSS_GROWTH_BYTES) {
+		std::cout << "FAIL: resident memory grew by " << (last.residentBytes - first.residentBytes) / 1024 << " KB" << std::endl;
+		failures++;
+	}
+
+	// Compare the average tick p99 of the last quarter of the games with the first quarter
+	const std::size_t quarter = std::max<std::size_t>(results.size() / 4, 1);
+	double earlyP99 = 0, lateP99 = 0;
+	for (std::size_t i = 0; i < quarter; ++i) {
+		earlyP99 += results[i].tickP99 / static_cast<double>(quarter);
+		lateP99 += results[results.size() - 1 - i].tickP99 / static_cast<double>(quarter);
+	}
+	if (lateP99 > earlyP99 * SOAK_TICK_GROWTH + SOAK_TICK_SLACK_NANOS) {
+		std::cout << "FAIL: tick p99 grew from " << static_cast<long long>(earlyP99) << " ns to "
+			<< static_cast<long long>(lateP99) << " ns" << std::endl;
+		failures++;
+	}
+
+	std::cout << (failures ? "Soak run failed" : "Soak run passed") << std::endl;
+	return failures ? 1 : 0;
+}
+
+// Handle spaceship collision and respawn logic
+void handleSpaceshipHit(sf::Sprite& ship, const sf::Vector2f& respawnPosition)
+{
+	spaceshipLives--; // Decrease lives
+	std::cout << "Spaceship hit! Lives remaining: " << spaceshipLives << std::endl;
+
+	// Remove the last life icon and respawn the spaceship
+	if (!spaceshipIcons.empty()) {
+		spaceshipIcons.pop_back();
+	}
+	ship.setPosition(respawnPosition); // Respawn the spaceship
 
 	// Check for game over condition
 	if (spaceshipIcons.empty()) {
 		std::cout << "Game Over! No lives left." << std::endl;
 		ended = true; // End the game
 		spaceship.setPosition(-100, -100); // Move spaceship off-screen
+		spaceship2.setPosition(-100, -100);
+	}
+}
+
+// Execute the spawns the wave scheduler hands out for this tick
+void runSpawnScheduler()
+{
+	spawnJobs.clear();
+	waveScheduler.tick(centipedeSegments.empty(), isSpiderParked(), spawnJobs);
+
+	// The scheduler hands out whole centipedes, so the segment ahead of a body segment was spawned in this call
+	ECE_Centipede* previousSegment = nullptr;
+	for (const SpawnJob& job : spawnJobs) {
+		if (job.type == SpawnJob::SEGMENT) {
+			// Take a segment allocated ahead of time when there is one
+			ECE_Centipede* segment = nullptr;
+			if (!segmentPool.empty()) {
+				segment = segmentPool.back();
+				segmentPool.pop_back();
+				*segment = ECE_Centipede(textureCentipedeHead, textureCentipedeBody, job.x, job.y, job.speed, job.segmentIndex);
+			}
+			else {
+				segment = new ECE_Centipede(textureCentipedeHead, textureCentipedeBody, job.x, job.y, job.speed, job.segmentIndex);
+			}
+
+			// Heads start a trail, body segments line up behind the segment of their centipede spawned before them.
+			// A body segment with no segment ahead of it leads a fresh trail as a head, like a split-off segment.
+			if (trailMovement) {
+				if (job.segmentIndex == 0 || !previousSegment) {
+					if (job.segmentIndex != 0) {
+						segment->setAsHead(textureCentipedeHead);
+					}
+					segment->startTrail();
+				}
+				else {
+					segment->joinChain(*previousSegment, SEGMENT_SPACING);
+				}
+			}
+			previousSegment = segment;
+			centipedeSegments.push_back(segment);
+		}
+		else if (job.type == SpawnJob::SPIDER) {
+			resetSpiderPosition();
+		}
+		else {
+			ECE_Mushroom mushroom(textureMashroom0);
+			mushroom.setPosition(job.x, job.y);
+			if (addMushroom(mushroom)) {
+				mushroomLayer.markDirty(mushrooms.back().getGlobalBounds());
+			}
+		}
+	}
+
+	// Allocate one segment per tick for the next wave so the transition doesn't allocate in a burst
+	if (static_cast<int>(segmentPool.size()) < waveScheduler.getNextWaveSegments()) {
+		segmentPool.push_back(new ECE_Centipede(textureCentipedeHead, textureCentipedeBody, 0, 0, 0, 1));
+	}
+}
+
+// Put the spider at the level's start position, or the bottom-right corner
+void resetSpiderPosition()
+{
+	spider.setPosition(playfieldWidth - spider.getGlobalBounds().width, playfieldHeight - spider.getGlobalBounds().height); // Bottom-right position
+	if (level.isOpen() && level.getHeader().spider.startX >= 0) {
+		spider.setPosition(level.getHeader().spider.startX, level.getHeader().spider.startY);
 	}
 }
 
+// A shot spider is parked at (-300, -300) until the scheduler brings it back
+bool isSpiderParked()
+{
+	return spider.getPosition().x < -100;
+}
+
 // Update spider movement
 void updateSpiderMovement()
 {
-	static bool movingLeft = true;  // Control horizontal movement direction
-	static bool movingUp = false;    // Control vertical movement direction
+	bool& movingLeft = spiderMovingLeft;  // Control horizontal movement direction
+	bool& movingUp = spiderMovingUp;      // Control vertical movement direction
 
-	const float spiderSpeedX = 0.02f; // Spider's horizontal speed
-	const float spiderSpeedY = 0.03f; // Spider's vertical speed
+	// A shot spider stays parked until it respawns
+	if (isSpiderParked()) {
+		return;
+	}
 
 	// Get the current position of the spider
 	float spiderX = spider.getPosition().x;
@@ -501,32 +1878,49 @@ void updateSpiderMovement()
 	}
 	else {
 		spiderX += spiderSpeedX; // Move right
-		if (spiderX + spider.getGlobalBounds().width >= 960) { // Reached the right boundary
+		if (spiderX + spider.getGlobalBounds().width >= playfieldWidth) { // Reached the right boundary
 			movingLeft = true;    // Change to move left
 			movingUp = !movingUp; // Change vertical direction
 		}
 	}
 
-	// Vertical movement control (oscillate between 300 and 540 in y direction)
+	// Vertical movement control (oscillate between spiderMinY and the bottom of the playfield)
 	if (movingUp) {
 		spiderY -= spiderSpeedY; // Move up
-		if (spiderY <= 300) {
+		if (spiderY <= spiderMinY) {
 			movingUp = false; // Change to move down
 		}
 	}
 	else {
 		spiderY += spiderSpeedY; // Move down
-		if (spiderY + spider.getGlobalBounds().height >= 540) {
+		if (spiderY + spider.getGlobalBounds().height >= playfieldHeight) {
 			movingUp = true; // Change to move up
 		}
 	}
 
-	// Check for collision with mushrooms every 60 frames
-	if (frameCounter % 60 == 0) {
+	// Check for collision with mushrooms on the spider's cadence
+	const bool checkMushrooms = gameTimers.fired(TIMER_SPIDER_MUSHROOMS);
+	if (checkMushrooms && useMushroomGrid()) {
+		// Eat the first mushroom on a tile under the spider
+		int column, row;
+		collisionTestCount++;
+		if (mushroomGrid.findInRect(spider.getGlobalBounds(), column, row)) {
+			auto mushroomIt = mushroomGrid.findMushroom(column, row);
+			mushroomLayer.markDirty(mushroomIt->getGlobalBounds());
+			mushroomGrid.remove(column, row);
+			mushrooms.erase(mushroomIt);
+			movingLeft = !movingLeft;
+		}
+	}
+	else if (checkMushrooms) {
 		// Use a non-const iterator to allow element deletion
 		for (auto mushroomIt = mushrooms.begin(); mushroomIt != mushrooms.end(); ) {
 			if (isOverlapping(spider, *mushroomIt)) {
+				mushroomLayer.markDirty(mushroomIt->getGlobalBounds());
 				mushroomIt = mushrooms.erase(mushroomIt); // Remove the current mushroom and get the next iterator
+				if (mushroomGridMode) {
+					mushroomGrid.rebuild(mushrooms);  // Keep the tile map in line for snapping
+				}
 				// Reverse horizontal and vertical direction upon collision
 				movingLeft = !movingLeft;
 				break; // Exit after collision direction change
@@ -544,6 +1938,8 @@ void updateSpiderMovement()
 // Check if two sprites are overlapping
 bool isOverlapping(const sf::Sprite& sprite1, const sf::Sprite& sprite2)
 {
+	collisionTestCount++;
+
 	// Get the global bounds of both sprites
 	sf::FloatRect bounds1 = sprite1.getGlobalBounds();
 	sf::FloatRect bounds2 = sprite2.getGlobalBounds();
@@ -552,14 +1948,487 @@ bool isOverlapping(const sf::Sprite& sprite1, const sf::Sprite& sprite2)
 	return bounds1.intersects(bounds2);
 }
 
-// Check for collision between the spaceship and mushrooms
-bool checkSpaceshipMushroomCollision()
+// Grid-snapped mode queries the tile map unless a differential run asks for the reference path
+bool useMushroomGrid()
+{
+	return mushroomGridMode && !referenceCollisions;
+}
+
+// Register each periodic system with its cadence. By default they all run on the same ticks, as
+// they always have; staggered, the collision and spider passes move off the centipede step's tick.
+// Both ships start on a full cooldown.
+void startGameTimers()
 {
+	gameTimers.reset();
+	gameTimers.schedulePeriodic(TIMER_CENTIPEDE_STEP, CENTIPEDE_STEP_TICKS, 0);
+	gameTimers.schedulePeriodic(TIMER_COLLISIONS, COLLISION_TICKS, staggerSystems ? COLLISION_TICKS / 2 : 0);
+	gameTimers.schedulePeriodic(TIMER_SPIDER_MUSHROOMS, SPIDER_MUSHROOM_TICKS, staggerSystems ? SPIDER_MUSHROOM_TICKS / 4 : 0);
+	gameTimers.schedulePeriodic(TIMER_WAVE_SPAWNS, WAVE_SPAWN_TICKS, 0);
+	gameTimers.schedule(TIMER_FIRE_COOLDOWN, FIRE_RATE);
+	gameTimers.schedule(TIMER_FIRE_COOLDOWN_2, FIRE_RATE);
+}
+
+// Check for collision between a spaceship and mushrooms
+bool checkSpaceshipMushroomCollision(const sf::Sprite& ship)
+{
+	// One tile map query in grid-snapped mode
+	if (useMushroomGrid()) {
+		collisionTestCount++;
+		return mushroomGrid.anyInRect(ship.getGlobalBounds());
+	}
+
 	// Iterate through all mushrooms to check for collisions with the spaceship
 	for (const auto& mushroom : mushrooms) {
-		if (isOverlapping(spaceship, mushroom)) {
+		if (isOverlapping(ship, mushroom)) {
 			return true; // Return true if a collision is detected
 		}
 	}
 	return false; // Return false if no collisions are found
 }
+
+// Snap a mushroom of the list to the tile under its center
+bool snapMushroom(std::list<ECE_Mushroom>::iterator mushroomIt)
+{
+	const sf::FloatRect bounds = mushroomIt->getGlobalBounds();
+	int column, row;
+	if (!mushroomGrid.tileAt(sf::Vector2f(bounds.left + bounds.width / 2, bounds.top + bounds.height / 2), column, row) ||
+		mushroomGrid.isOccupied(column, row)) {
+		return false;
+	}
+	mushroomIt->setPosition(mushroomGrid.tilePosition(column, row));
+	mushroomGrid.place(column, row, mushroomIt);
+	return true;
+}
+
+// The tile map keeps list positions, so a mushroom is snapped once it is in the list
+bool addMushroom(const ECE_Mushroom& mushroom)
+{
+	mushrooms.push_back(mushroom);
+	if (mushroomGridMode && !snapMushroom(std::prev(mushrooms.end()))) {
+		mushrooms.pop_back();
+		return false;
+	}
+	return true;
+}
+
+// Snap the mushrooms from position firstNew to the end of the list
+void snapNewMushrooms(std::size_t firstNew)
+{
+	auto mushroomIt = mushrooms.begin();
+	std::advance(mushroomIt, firstNew);
+	while (mushroomIt != mushrooms.end()) {
+		if (snapMushroom(mushroomIt)) {
+			++mushroomIt;
+		}
+		else {
+			mushroomIt = mushrooms.erase(mushroomIt);
+		}
+	}
+}
+
+// Serialize the full game state into a compact binary snapshot
+void saveGameSnapshot(std::vector<std::uint8_t>& buffer, bool includeRng)
+{
+	ECE_SnapshotWriter writer(buffer);
+
+	// Counters and game status
+	writer.write(score);
+	writer.write(spaceshipLives);
+	writer.write(paused);
+	writer.write(ended);
+	writer.write(playerWon);
+
+	// Spaceship, spider and the spider's movement flags
+	writer.write(spaceship.getPosition());
+	writer.write(initialSpaceshipPosition);
+	writer.write(spaceship2.getPosition());
+	writer.write(initialSpaceship2Position);
+	writer.write(static_cast<std::uint32_t>(spaceshipIcons.size()));
+	writer.write(spider.getPosition());
+	writer.write(spiderMovingLeft);
+	writer.write(spiderMovingUp);
+
+	// Periodic systems and cooldowns, then wave progression
+	gameTimers.saveState(writer);
+	waveScheduler.saveState(writer);
+
+	// Centipede segments in list order
+	writer.write(static_cast<std::uint32_t>(centipedeSegments.size()));
+	for (const auto& body : centipedeSegments) {
+		body->saveState(writer);
+	}
+	ECE_Centipede::saveTrails(centipedeSegments, writer);
+
+	// Mushrooms with their damage state
+	writer.write(static_cast<std::uint32_t>(mushrooms.size()));
+	for (const auto& mushroom : mushrooms) {
+		writer.write(mushroom.getPosition());
+		writer.write(static_cast<std::uint8_t>(mushroom.getDamage()));
+	}
+
+	// Lasers (idle ones are parked off-screen)
+	writer.write(static_cast<std::uint32_t>(laserBlasts.size()));
+	for (const auto& laser : laserBlasts) {
+		writer.write(laser.getPosition());
+		writer.write(laser.isActive());
+	}
+
+	// Random number generator state, only used by initGame so rollback snapshots leave it out
+	writer.write(includeRng);
+	if (includeRng) {
+		writer.write(gen.getSeed());
+		writer.write(gen.getDraws());
+	}
+
+	writer.finish();
+}
+
+// Decode a whole snapshot without touching the game
+bool decodeGameSnapshot(const std::vector<std::uint8_t>& buffer, DecodedSnapshot& state)
+{
+	ECE_SnapshotReader reader(buffer.data(), buffer.size());
+	if (!reader.isValid()) {
+		return false;
+	}
+
+	// Counters, game status, ships, life icons (one per remaining life) and the spider
+	if (!reader.read(state.score) || !reader.read(state.spaceshipLives) || !reader.read(state.paused) ||
+		!reader.read(state.ended) || !reader.read(state.playerWon) ||
+		!reader.read(state.spaceshipPosition) || !reader.read(state.initialSpaceshipPosition) ||
+		!reader.read(state.spaceship2Position) || !reader.read(state.initialSpaceship2Position) ||
+		!reader.read(state.lifeIcons) || state.lifeIcons > static_cast<std::uint32_t>(std::max(state.spaceshipLives, 0)) ||
+		!reader.read(state.spiderPosition) || !reader.read(state.spiderMovingLeft) || !reader.read(state.spiderMovingUp)) {
+		return false;
+	}
+
+	// Periodic systems and cooldowns, then wave progression (the scheduler keeps the waves being played)
+	state.waves = waveScheduler;
+	if (!state.timers.loadState(reader) || !state.waves.loadState(reader)) {
+		return false;
+	}
+
+	// Centipede segments, decoded into spare objects that are kept between restores
+	std::uint32_t count = 0;
+	if (!reader.readCount(count, ECE_Centipede::STATE_SIZE)) {
+		return false;
+	}
+	while (state.segments.size() > count) {
+		delete state.segments.back();
+		state.segments.pop_back();
+	}
+	while (state.segments.size() < count) {
+		state.segments.push_back(new ECE_Centipede(textureCentipedeHead, textureCentipedeBody, 0, 0, 0, 1));
+	}
+	for (auto& body : state.segments) {
+		if (!body->loadState(reader, textureCentipedeHead, textureCentipedeBody)) {
+			return false;
+		}
+	}
+	if (!ECE_Centipede::loadTrails(state.segments, reader)) {
+		return false;
+	}
+
+	// Mushrooms
+	if (!reader.readCount(count, MUSHROOM_RECORD_SIZE)) {
+		return false;
+	}
+	state.mushrooms.resize(count);
+	for (auto& mushroom : state.mushrooms) {
+		sf::Vector2f position;
+		std::uint8_t damage = 0;
+		if (!reader.read(position) || !reader.read(damage) || damage > 1) {
+			return false;  // Damage is 0 (healthy) or 1 (damaged)
+		}
+		mushroom.x = position.x;
+		mushroom.y = position.y;
+		mushroom.damage = damage;
+	}
+
+	// Lasers
+	if (!reader.readCount(count, LASER_RECORD_SIZE)) {
+		return false;
+	}
+	state.lasers.resize(count);
+	for (auto& laser : state.lasers) {
+		if (!reader.read(laser.first) || !reader.read(laser.second)) {
+			return false;
+		}
+	}
+
+	// Random number generator state
+	if (!reader.read(state.hasRng) ||
+		(state.hasRng && (!reader.read(state.rngSeed) || !reader.read(state.rngDraws) || state.rngDraws > MAX_RNG_DRAWS))) {
+		return false;
+	}
+	return reader.isValid();
+}
+
+// Restore the full game state from a snapshot, all or nothing: a snapshot that doesn't decode leaves the game as it was
+bool restoreGameSnapshot(const std::vector<std::uint8_t>& buffer)
+{
+	DecodedSnapshot& state = restoredState;
+	if (!decodeGameSnapshot(buffer, state)) {
+		return false;
+	}
+
+	// Counters and game status
+	score = state.score;
+	spaceshipLives = state.spaceshipLives;
+	paused = state.paused;
+	ended = state.ended;
+	playerWon = state.playerWon;
+
+	// Spaceships and life icons
+	spaceship.setPosition(state.spaceshipPosition);
+	initialSpaceshipPosition = state.initialSpaceshipPosition;
+	spaceship2.setPosition(state.spaceship2Position);
+	initialSpaceship2Position = state.initialSpaceship2Position;
+	spaceshipIcons.clear();
+	for (std::uint32_t i = 0; i < state.lifeIcons; ++i) {
+		sf::Sprite lifeIcon;
+		setSpriteTexture(lifeIcon, textureStarship);
+		lifeIcon.setPosition(900 - i * 25, 10);
+		spaceshipIcons.push_back(lifeIcon);
+	}
+
+	// Spider and its movement flags
+	spider.setPosition(state.spiderPosition);
+	spiderMovingLeft = state.spiderMovingLeft;
+	spiderMovingUp = state.spiderMovingUp;
+
+	// Timers, waves and segments are swapped in, the replaced ones are reused by the next restore
+	std::swap(gameTimers, state.timers);
+	std::swap(waveScheduler, state.waves);
+	centipedeSegments.swap(state.segments);
+
+	// Mushrooms
+	mushrooms.resize(state.mushrooms.size(), ECE_Mushroom(textureMashroom0));
+	auto record = state.mushrooms.begin();
+	for (auto& mushroom : mushrooms) {
+		mushroom.setPosition(record->x, record->y);
+		mushroom.setDamage(record->damage, textureMashroom0, textureMashroom1);
+		++record;
+	}
+	if (mushroomGridMode) {
+		mushroomGrid.rebuild(mushrooms);  // The tile map isn't saved, it follows from the list
+	}
+	mushroomLayer.invalidate();
+
+	// Lasers
+	ECE_LaserBlast idleLaser(textureLaser);
+	idleLaser.setScale(0.5f, 0.5f);
+	laserBlasts.resize(state.lasers.size(), idleLaser);
+	auto laserState = state.lasers.begin();
+	for (auto& laser : laserBlasts) {
+		if (laserState->second) {
+			laser.fire(laserState->first);
+		}
+		else {
+			laser.park();
+		}
+		++laserState;
+	}
+
+	// Random number generator state
+	if (state.hasRng) {
+		gen.restore(state.rngSeed, state.rngDraws);
+	}
+
+	// Refresh the score text from the restored score
+	updateScoreText();
+
+	return true;
+}
+
+// Move a spaceship and fire a laser according to one tick of player input
+void applyPlayerInput(sf::Sprite& ship, GameTimer fireCooldown, PlayerInput input)
+{
+	// Spaceship movement controls (left, right, up, down)
+	if ((input & INPUT_LEFT) && ship.getPosition().x > 0)
+	{
+		ship.move(-0.3f, 0);
+		if (checkSpaceshipMushroomCollision(ship)) ship.move(0.2f, 0);  // Undo movement if collision occurs
+	}
+
+	if ((input & INPUT_RIGHT) && ship.getPosition().x < playfieldWidth - 20)
+	{
+		ship.move(0.3f, 0);
+		if (checkSpaceshipMushroomCollision(ship)) ship.move(-0.2f, 0);  // Undo movement if collision occurs
+	}
+
+	if ((input & INPUT_UP) && ship.getPosition().y > 0)
+	{
+		ship.move(0, -0.3f);
+		if (checkSpaceshipMushroomCollision(ship)) ship.move(0, 0.2f);  // Undo movement if collision occurs
+	}
+
+	if ((input & INPUT_DOWN) && ship.getPosition().y < playfieldHeight - 30)
+	{
+		ship.move(0, 0.3f);
+		if (checkSpaceshipMushroomCollision(ship)) ship.move(0, -0.2f);  // Undo movement if collision occurs
+	}
+
+	// Fire a laser once the cooldown has run out
+	if ((input & INPUT_FIRE) && !gameTimers.isScheduled(fireCooldown))
+	{
+		// Find an idle laser and fire it from the ship
+		for (auto& laser : laserBlasts)
+		{
+			if (!laser.isActive())
+			{
+				laser.fire(ship.getPosition());  // Set laser position
+				gameTimers.schedule(fireCooldown, FIRE_RATE);  // Start the cooldown
+				break;  // Only fire one laser at a time
+			}
+		}
+	}
+}
+
+// Advance the game by one tick with both players' inputs (the rollback session's step function)
+void simulateTick(PlayerInput playerOne, PlayerInput playerTwo)
+{
+	applyPlayerInput(spaceship, TIMER_FIRE_COOLDOWN, playerOne);
+	if (twoPlayerMode) {
+		applyPlayerInput(spaceship2, TIMER_FIRE_COOLDOWN_2, playerTwo);
+	}
+
+	updateGame();
+}
+
+// Look a texture up in the snapshot texture table, TEXTURE_COUNT if it isn't there
+std::uint8_t getTextureId(const sf::Texture* texture)
+{
+	for (int id = 0; id < TEXTURE_COUNT; ++id) {
+		if (snapshotTextures[id] == texture) {
+			return static_cast<std::uint8_t>(id);
+		}
+	}
+	return TEXTURE_COUNT;
+}
+
+// Copy the sprites drawScene would draw, in the same order, plus the values of the score text
+void captureRenderSnapshot(RenderSnapshot& snapshot)
+{
+	auto addSprite = [&snapshot](const sf::Sprite& sprite)
+	{
+		snapshot.sprites.push_back(makeRenderSprite(sprite, getTextureId(sprite.getTexture())));
+	};
+
+	snapshot.sprites.clear();
+	addSprite(spaceship);
+	if (twoPlayerMode) {
+		addSprite(spaceship2);
+	}
+	if (!isSpiderParked()) {
+		addSprite(spider);
+	}
+	snapshot.hudIndex = snapshot.sprites.size();
+	for (const auto& spaceshipIcon : spaceshipIcons) {
+		addSprite(spaceshipIcon);
+	}
+	for (const auto& laser : laserBlasts) {
+		if (laser.isActive()) {
+			addSprite(laser);
+		}
+	}
+	for (const auto& mushroom : mushrooms) {
+		addSprite(mushroom);
+	}
+	for (const auto& body : centipedeSegments) {
+		addSprite(*body);
+	}
+
+	snapshot.tick = ticksSimulated;
+	snapshot.score = score;
+	snapshot.wave = waveScheduler.getWave();
+	snapshot.ended = ended;
+}
+
+// Tick at SIM_TICK_RATE and publish a snapshot after every tick. The main thread only reads
+// snapshots, so a slow frame doesn't hold up the simulation or its input.
+void runSimulationThread()
+{
+	const std::chrono::nanoseconds tickPeriod(1000000000 / SIM_TICK_RATE);
+	std::chrono::steady_clock::time_point nextTick = std::chrono::steady_clock::now();
+
+	while (simulationRunning.load(std::memory_order_acquire) && !ended)
+	{
+		const std::chrono::steady_clock::time_point tickStart = std::chrono::steady_clock::now();
+		simulateTick(simulationInput.load(std::memory_order_relaxed), 0);
+		captureRenderSnapshot(renderSnapshots.beginWrite());
+		renderSnapshots.publish();
+		simulationTicks++;
+
+		const sf::Int64 updateMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - tickStart).count();
+		publishMetrics(updateMicros, renderDrawMicros.load(std::memory_order_relaxed), updateMicros);
+
+		// Run late ticks back to back, but after a long stall start over from now instead of bursting
+		nextTick += tickPeriod;
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (now > nextTick) {
+			simulationLateTicks++;
+			if (now - nextTick > tickPeriod * SIM_MAX_CATCHUP_TICKS) {
+				nextTick = now;
+			}
+		}
+		else {
+			std::this_thread::sleep_until(nextTick);
+		}
+	}
+}
+
+// Print rollback depth, resimulation time and link statistics
+void printRollbackMetrics(const ECE_RollbackSession& session, const ECE_NetTransport& transport)
+{
+	const ECE_RollbackMetrics& metrics = session.getMetrics();
+	std::cout << "Rollback: ticks " << metrics.ticks
+		<< ", rollbacks " << metrics.rollbacks
+		<< ", depth last/max/avg " << metrics.lastDepth << "/" << metrics.maxDepth << "/"
+		<< (metrics.rollbacks ? static_cast<double>(metrics.resimulatedTicks) / metrics.rollbacks : 0.0)
+		<< ", resim us last/max/avg " << metrics.lastResimMicros << "/" << metrics.maxResimMicros << "/"
+		<< (metrics.rollbacks ? metrics.totalResimMicros / metrics.rollbacks : 0)
+		<< ", stalls " << metrics.stalls
+		<< ", packets sent/dropped/received " << transport.getPacketsSent() << "/"
+		<< transport.getPacketsDropped() << "/" << transport.getPacketsReceived() << std::endl;
+}
+
+// Gather the counters and publish them as one seqlock update
+void publishMetrics(sf::Int64 updateMicros, sf::Int64 drawMicros, sf::Int64 frameMicros)
+{
+	if (!metricsSegment.isOpen()) {
+		return;
+	}
+
+	framesPresented++;
+	if (frameMicros > FRAME_BUDGET_MICROS) {
+		framesDropped++;
+	}
+	updateMicrosMax = std::max(updateMicrosMax, updateMicros);
+	drawMicrosMax = std::max(drawMicrosMax, drawMicros);
+
+	std::uint64_t lasersInFlight = 0;
+	for (const auto& laser : laserBlasts) {
+		lasersInFlight += laser.isActive() ? 1 : 0;
+	}
+
+	MetricsSample sample = {};
+	sample.values[METRIC_FRAMES] = framesPresented;
+	sample.values[METRIC_FRAMES_DROPPED] = framesDropped;
+	sample.values[METRIC_TICKS] = ticksSimulated;
+	sample.values[METRIC_UPDATE_MICROS] = static_cast<std::uint64_t>(updateMicros);
+	sample.values[METRIC_UPDATE_MICROS_MAX] = static_cast<std::uint64_t>(updateMicrosMax);
+	sample.values[METRIC_DRAW_MICROS] = static_cast<std::uint64_t>(drawMicros);
+	sample.values[METRIC_DRAW_MICROS_MAX] = static_cast<std::uint64_t>(drawMicrosMax);
+	sample.values[METRIC_SEGMENTS] = centipedeSegments.size();
+	sample.values[METRIC_MUSHROOMS] = mushrooms.size();
+	sample.values[METRIC_LASERS] = lasersInFlight;
+	sample.values[METRIC_SPIDERS] = isSpiderParked() ? 0 : 1;
+	sample.values[METRIC_COLLISION_TESTS] = collisionTestCount;
+	sample.values[METRIC_ALLOCATIONS] = getAllocationCount();
+	sample.values[METRIC_WAVE] = static_cast<std::uint64_t>(waveScheduler.getWave());
+	sample.values[METRIC_SCORE] = static_cast<std::uint64_t>(std::max(score, 0));
+	sample.values[METRIC_SUBMITTED] = renderCuller.getSubmitted();
+	sample.values[METRIC_CULLED] = renderCuller.getCulled();
+	metricsSegment.publish(sample);
+}
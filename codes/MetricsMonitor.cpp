@@ -0,0 +1,70 @@
+/*
+Author: Junkai Li
+Class: ECE6122
+Last Date Modified: 10/19/2026
+Description:
+Companion monitor for the game's live metrics. Maps the shared-memory segment a
+game instance publishes with --metrics <name> and prints its counters, once or
+every interval until the instance goes away.
+
+Usage: CentipedeMetrics <name> [intervalMs]
+*/
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include "ECE_Metrics.h"
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <name> [intervalMs]" << std::endl;
+        return 1;
+    }
+    const std::string name = argv[1];
+    const int intervalMs = (argc > 2) ? std::atoi(argv[2]) : 0;  // 0 = print once
+
+    ECE_MetricsSegment metrics;
+    std::string error;
+    if (!metrics.attach(name, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    MetricsSample previous = {};
+    bool havePrevious = false;
+    while (true) {
+        MetricsSample sample;
+        if (!metrics.read(sample)) {
+            std::cerr << "Metrics segment is busy, skipping" << std::endl;
+        }
+        else {
+            // One line per counter, with the change since the last print for the running totals
+            for (int i = 0; i < METRIC_COUNT; ++i) {
+                std::cout << std::left << std::setw(18) << METRIC_NAMES[i] << std::right << std::setw(14) << sample.values[i];
+                if (havePrevious && sample.values[i] >= previous.values[i] &&
+                    (i == METRIC_FRAMES || i == METRIC_FRAMES_DROPPED || i == METRIC_TICKS ||
+                     i == METRIC_COLLISION_TESTS || i == METRIC_ALLOCATIONS)) {
+                    std::cout << "  (+" << sample.values[i] - previous.values[i] << ")";
+                }
+                std::cout << "\n";
+            }
+            std::cout << std::endl;
+            previous = sample;
+            havePrevious = true;
+        }
+
+        if (intervalMs <= 0) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+
+        // Stop once the game has closed the segment or exited
+        if (!metrics.isWriterRunning()) {
+            std::cout << "The game writing " << name << " has exited" << std::endl;
+            break;
+        }
+    }
+    return 0;
+}